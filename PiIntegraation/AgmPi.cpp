@@ -0,0 +1,129 @@
+﻿/**
+ * @file AgmPi.cpp
+ * @brief Implementacja algorytmu Gaussa-Legendre'a dla liczby PI.
+ */
+
+#include "AgmPi.h"
+#include "CommandLine.h"
+#include "ProcessStats.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+/// Pierwsze 100 cyfr liczby PI do kontroli wyniku.
+const char* referenceDigits =
+    "3.1415926535897932384626433832795028841971693993751058209749445923078164062862089986280348253421170679";
+
+/**
+ * @brief Wykonuje dwie niezależne operacje równolegle (lub po kolei bez puli).
+ */
+template <typename First, typename Second>
+void runBoth(ThreadPool* pool, First first, Second second) {
+    if (pool == nullptr) {
+        first();
+        second();
+        return;
+    }
+    pool->parallelFor(2, 2, [&](long long begin, long long, int) {
+        if (begin == 0) {
+            first();
+        }
+        else {
+            second();
+        }
+    });
+}
+
+/// Największa liczba iteracji, dla której pₙ = 2ⁿ mieści się w jednym limbie.
+constexpr int maxIterations = 29;
+
+} // namespace
+
+AgmResult computePiAgm(int digits, ThreadPool* pool) {
+    // Dwa limby zapasu na błędy zaokrągleń
+    int precision = (digits + limbDigits - 1) / limbDigits + 2;
+
+    FixedPoint a = FixedPoint::fromInteger(1, precision);
+    FixedPoint b = inverseSqrt(FixedPoint::fromInteger(2, precision), pool);
+    FixedPoint t = divideSmall(a, 4);
+    uint32_t power = 1;
+
+    AgmResult result;
+    while (true) {
+        ++result.iterations;
+        FixedPoint next = divideSmall(a + b, 2);
+        FixedPoint halfDifference = divideSmall(absoluteDifference(a, b), 2); // aₙ − aₙ₊₁
+
+        // bₙ₊₁ = √(aₙbₙ) oraz tₙ₊₁ = tₙ − pₙ(aₙ − aₙ₊₁)² są niezależne
+        FixedPoint root(precision);
+        FixedPoint correction(precision);
+        runBoth(pool,
+            [&] { root = squareRoot(multiply(a, b, pool), pool); },
+            [&] { correction = multiply(halfDifference, halfDifference, pool); });
+        correction = multiplySmall(correction, power);
+        t = t - correction;
+        a = next;
+        b = root;
+        power *= 2;
+
+        // Zbieżność kwadratowa: gdy różnica ma połowę precyzji, kolejna iteracja nic nie zmienia
+        // (limit iteracji utrzymuje pₙ = 2ⁿ poniżej limbBase - wystarcza na ~10^9 cyfr)
+        if (halfDifference.isBelow(precision / 2) || result.iterations >= maxIterations) {
+            break;
+        }
+    }
+
+    FixedPoint sum = a + b;
+    result.pi = divide(multiply(sum, sum, pool), multiplySmall(t, 4), pool);
+    return result;
+}
+
+int runAgmMode(int argc, char* argv[]) {
+    string digitsList = getOption(argc, argv, "--digits", "1000,10000,100000");
+    int numThreads = static_cast<int>(getIntOption(argc, argv, "--threads", thread::hardware_concurrency()));
+    string outputPath = getOption(argc, argv, "--output", "");
+
+    vector<int> sizes;
+    stringstream stream(digitsList);
+    for (string item; getline(stream, item, ',');) {
+        sizes.push_back(max(1, static_cast<int>(stod(item))));
+    }
+
+    ThreadPool pool(static_cast<unsigned>(max(1, numThreads)));
+    string digits;
+    for (int size : sizes) {
+        auto startTime = chrono::high_resolution_clock::now();
+        AgmResult result = computePiAgm(size, &pool);
+        digits = result.pi.toDecimal(size);
+        auto endTime = chrono::high_resolution_clock::now();
+        chrono::duration<double> duration = endTime - startTime;
+
+        size_t checked = min(digits.size(), char_traits<char>::length(referenceDigits));
+        bool matches = digits.compare(0, checked, referenceDigits, checked) == 0;
+        cout << "Cyfry: " << size << ", Iteracje: " << result.iterations << ", Wątki: " << pool.size()
+            << ", Czas: " << duration.count() << "s, Cyfry/s: " << size / duration.count()
+            << ", Pamięć szczytowa: " << peakMemoryBytes() / (1024.0 * 1024.0) << " MB"
+            << ", Zgodność: " << (matches ? "tak" : "NIE") << endl;
+    }
+
+    if (!outputPath.empty()) {
+        ofstream outputFile(outputPath);
+        if (!outputFile.is_open()) {
+            cerr << "Nie można otworzyć pliku " << outputPath << " do zapisu." << endl;
+            return 1;
+        }
+        outputFile << digits << "\n";
+        cout << "Cyfry zapisane do pliku " << outputPath << endl;
+    }
+    return 0;
+}
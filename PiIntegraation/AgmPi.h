@@ -0,0 +1,49 @@
+﻿/**
+ * @file AgmPi.h
+ * @brief Obliczanie cyfr liczby PI algorytmem Gaussa-Legendre'a (Brent-Salamin, AGM).
+ *
+ * Algorytm oparty na średniej arytmetyczno-geometrycznej zbiega kwadratowo:
+ * każda iteracja podwaja liczbę poprawnych cyfr, więc milion cyfr wymaga
+ * około 20 iteracji. Koszt każdej iteracji to kilka mnożeń i pierwiastek
+ * w pełnej precyzji (BigNumber.h).
+ */
+
+#pragma once
+
+#include "BigNumber.h"
+
+class ThreadPool;
+
+/**
+ * @brief Wynik obliczenia liczby PI metodą AGM.
+ */
+struct AgmResult {
+    FixedPoint pi;      ///< Przybliżenie liczby PI.
+    int iterations = 0; ///< Liczba iteracji AGM.
+};
+
+/**
+ * @brief Oblicza liczbę PI z dokładnością do \p digits cyfr po przecinku.
+ *
+ * ### Wyjaśnienie działania:
+ * - a₀ = 1, b₀ = 1/√2, t₀ = 1/4, p₀ = 1.
+ * - aₙ₊₁ = (aₙ + bₙ)/2, bₙ₊₁ = √(aₙbₙ), tₙ₊₁ = tₙ − pₙ(aₙ − aₙ₊₁)², pₙ₊₁ = 2pₙ.
+ * - π ≈ (a + b)² / (4t).
+ * W każdej iteracji pierwiastek i aktualizacja t są niezależne i wykonywane
+ * równolegle, a mnożenia dużych liczb dodatkowo dzielą pracę między wątki puli.
+ *
+ * @param digits Liczba cyfr po przecinku.
+ * @param pool Pula wątków (lub nullptr dla obliczeń sekwencyjnych).
+ */
+AgmResult computePiAgm(int digits, ThreadPool* pool);
+
+/**
+ * @brief Uruchamia tryb `agm`.
+ *
+ * Opcje: `--digits n[,n...]` (lista rozmiarów do porównania), `--threads n`,
+ * `--output plik` (zapis cyfr ostatniego rozmiaru). Dla każdego rozmiaru
+ * wypisywany jest czas, liczba cyfr na sekundę i szczytowe zużycie pamięci.
+ *
+ * @return Kod zakończenia programu.
+ */
+int runAgmMode(int argc, char* argv[]);
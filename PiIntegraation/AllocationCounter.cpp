@@ -0,0 +1,250 @@
+﻿/**
+ * @file AllocationCounter.cpp
+ * @brief Zastępcze operatory new / delete zliczające alokacje.
+ */
+
+#include "AllocationCounter.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+
+using namespace std;
+
+namespace {
+
+/**
+ * @brief Liczniki jednego wątku.
+ *
+ * Zapisuje je tylko wątek właściciel (load + store, bez blokady magistrali);
+ * atomowość pozwala processAllocations() czytać je z innego wątku. Blok jest
+ * trywialnie destruowalny, więc pozostaje dostępny nawet dla alokacji
+ * wykonywanych przez destruktory innych zmiennych thread_local.
+ */
+struct alignas(64) ThreadCounters {
+    atomic<long long> allocations{ 0 };
+    atomic<long long> deallocations{ 0 };
+    atomic<long long> bytes{ 0 };
+    ThreadCounters* next = nullptr; ///< Lista zarejestrowanych bloków (chroniona przez registryMutex).
+    bool registered = false;
+};
+
+thread_local ThreadCounters threadCounters;
+
+// Rejestr używany tylko przy starcie i końcu wątku oraz w processAllocations();
+// żadna z tych operacji nie wywołuje operator new.
+mutex registryMutex;
+ThreadCounters* registeredThreads = nullptr;
+AllocationCounters finishedThreads; ///< Sumy wątków już zakończonych.
+
+AllocationCounters snapshot(const ThreadCounters& counters) {
+    AllocationCounters result;
+    result.allocations = counters.allocations.load(memory_order_relaxed);
+    result.deallocations = counters.deallocations.load(memory_order_relaxed);
+    result.bytes = counters.bytes.load(memory_order_relaxed);
+    return result;
+}
+
+/**
+ * @brief Wyrejestrowuje blok wątku przy jego zakończeniu, przenosząc liczniki do finishedThreads.
+ */
+struct ThreadUnregister {
+    ~ThreadUnregister() {
+        lock_guard<mutex> lock(registryMutex);
+        for (ThreadCounters** link = &registeredThreads; *link; link = &(*link)->next) {
+            if (*link == &threadCounters) {
+                *link = threadCounters.next;
+                break;
+            }
+        }
+        AllocationCounters counters = snapshot(threadCounters);
+        finishedThreads.allocations += counters.allocations;
+        finishedThreads.deallocations += counters.deallocations;
+        finishedThreads.bytes += counters.bytes;
+    }
+};
+
+void registerThread() {
+    threadCounters.registered = true;
+    {
+        lock_guard<mutex> lock(registryMutex);
+        threadCounters.next = registeredThreads;
+        registeredThreads = &threadCounters;
+    }
+    thread_local ThreadUnregister unregister;
+    (void)unregister;
+}
+
+inline void add(atomic<long long>& counter, long long value) {
+    counter.store(counter.load(memory_order_relaxed) + value, memory_order_relaxed);
+}
+
+void recordAllocation(size_t size) {
+    if (!threadCounters.registered) {
+        registerThread();
+    }
+    add(threadCounters.allocations, 1);
+    add(threadCounters.bytes, static_cast<long long>(size));
+}
+
+void recordDeallocation(void* pointer) {
+    if (pointer) {
+        if (!threadCounters.registered) {
+            registerThread();
+        }
+        add(threadCounters.deallocations, 1);
+    }
+}
+
+void* allocate(size_t size) {
+    recordAllocation(size);
+    return malloc(size > 0 ? size : 1);
+}
+
+void* allocateAligned(size_t size, align_val_t alignment) {
+    recordAllocation(size);
+    size_t align = static_cast<size_t>(alignment);
+#ifdef _WIN32
+    return _aligned_malloc(size > 0 ? size : 1, align);
+#else
+    // aligned_alloc wymaga rozmiaru będącego wielokrotnością wyrównania
+    size_t rounded = (max<size_t>(size, 1) + align - 1) / align * align;
+    return aligned_alloc(align, rounded);
+#endif
+}
+
+void release(void* pointer) {
+    recordDeallocation(pointer);
+    free(pointer);
+}
+
+void releaseAligned(void* pointer) {
+    recordDeallocation(pointer);
+#ifdef _WIN32
+    _aligned_free(pointer);
+#else
+    free(pointer);
+#endif
+}
+
+template <typename Allocator>
+void* allocateOrThrow(Allocator allocator) {
+    for (;;) {
+        if (void* pointer = allocator()) {
+            return pointer;
+        }
+        new_handler handler = get_new_handler();
+        if (!handler) {
+            throw bad_alloc();
+        }
+        handler();
+    }
+}
+
+} // namespace
+
+AllocationCounters threadAllocations() {
+    return snapshot(threadCounters);
+}
+
+AllocationCounters processAllocations() {
+    lock_guard<mutex> lock(registryMutex);
+    AllocationCounters counters = finishedThreads;
+    for (const ThreadCounters* thread = registeredThreads; thread; thread = thread->next) {
+        AllocationCounters current = snapshot(*thread);
+        counters.allocations += current.allocations;
+        counters.deallocations += current.deallocations;
+        counters.bytes += current.bytes;
+    }
+    return counters;
+}
+
+AllocationCounters operator-(const AllocationCounters& after, const AllocationCounters& before) {
+    AllocationCounters difference;
+    difference.allocations = after.allocations - before.allocations;
+    difference.deallocations = after.deallocations - before.deallocations;
+    difference.bytes = after.bytes - before.bytes;
+    return difference;
+}
+
+void* operator new(size_t size) {
+    return allocateOrThrow([&] { return allocate(size); });
+}
+
+void* operator new[](size_t size) {
+    return allocateOrThrow([&] { return allocate(size); });
+}
+
+void* operator new(size_t size, const nothrow_t&) noexcept {
+    return allocate(size);
+}
+
+void* operator new[](size_t size, const nothrow_t&) noexcept {
+    return allocate(size);
+}
+
+void* operator new(size_t size, align_val_t alignment) {
+    return allocateOrThrow([&] { return allocateAligned(size, alignment); });
+}
+
+void* operator new[](size_t size, align_val_t alignment) {
+    return allocateOrThrow([&] { return allocateAligned(size, alignment); });
+}
+
+void* operator new(size_t size, align_val_t alignment, const nothrow_t&) noexcept {
+    return allocateAligned(size, alignment);
+}
+
+void* operator new[](size_t size, align_val_t alignment, const nothrow_t&) noexcept {
+    return allocateAligned(size, alignment);
+}
+
+void operator delete(void* pointer) noexcept {
+    release(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+    release(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+    release(pointer);
+}
+
+void operator delete[](void* pointer, size_t) noexcept {
+    release(pointer);
+}
+
+void operator delete(void* pointer, const nothrow_t&) noexcept {
+    release(pointer);
+}
+
+void operator delete[](void* pointer, const nothrow_t&) noexcept {
+    release(pointer);
+}
+
+void operator delete(void* pointer, align_val_t) noexcept {
+    releaseAligned(pointer);
+}
+
+void operator delete[](void* pointer, align_val_t) noexcept {
+    releaseAligned(pointer);
+}
+
+void operator delete(void* pointer, size_t, align_val_t) noexcept {
+    releaseAligned(pointer);
+}
+
+void operator delete[](void* pointer, size_t, align_val_t) noexcept {
+    releaseAligned(pointer);
+}
+
+void operator delete(void* pointer, align_val_t, const nothrow_t&) noexcept {
+    releaseAligned(pointer);
+}
+
+void operator delete[](void* pointer, align_val_t, const nothrow_t&) noexcept {
+    releaseAligned(pointer);
+}
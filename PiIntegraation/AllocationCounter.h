@@ -0,0 +1,32 @@
+﻿/**
+ * @file AllocationCounter.h
+ * @brief Zliczanie alokacji na stercie przez zastąpienie globalnego operatora new.
+ *
+ * AllocationCounter.cpp definiuje wszystkie warianty operator new / delete
+ * (zwykłe, tablicowe, nothrow, z wyrównaniem), które oprócz przydziału pamięci
+ * zwiększają wyłącznie liczniki bieżącego wątku (thread_local, we własnej linii
+ * pamięci podręcznej, bez operacji atomowych typu odczyt-modyfikacja-zapis).
+ * Blok liczników wątku jest rejestrowany przy jego pierwszej alokacji, a sumy
+ * całego procesu oblicza processAllocations() z zarejestrowanych bloków
+ * i liczników wątków już zakończonych.
+ */
+
+#pragma once
+
+/**
+ * @brief Stan liczników alokacji.
+ */
+struct AllocationCounters {
+    long long allocations = 0;   ///< Liczba wywołań operator new.
+    long long deallocations = 0; ///< Liczba wywołań operator delete (dla niepustych wskaźników).
+    long long bytes = 0;         ///< Łączna liczba przydzielonych bajtów.
+};
+
+/// Liczniki alokacji wykonanych przez bieżący wątek.
+AllocationCounters threadAllocations();
+
+/// Liczniki alokacji wykonanych przez wszystkie wątki procesu.
+AllocationCounters processAllocations();
+
+/// Różnica liczników \p after − \p before.
+AllocationCounters operator-(const AllocationCounters& after, const AllocationCounters& before);
@@ -0,0 +1,81 @@
+﻿/**
+ * @file BatchIntegration.cpp
+ * @brief Implementacja wsadowego całkowania na wspólnej puli i trybu `nested`.
+ */
+
+#include "BatchIntegration.h"
+#include "CommandLine.h"
+#include "Integration.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+using namespace std;
+
+double integrateOnPool(ThreadPool& pool, long long steps, int chunks) {
+    double stepSize = 1.0 / static_cast<double>(steps);
+    chunks = static_cast<int>(max(1LL, min<long long>(chunks, steps)));
+    vector<double> partials(chunks, 0.0);
+    pool.parallelFor(steps, chunks, [&](long long begin, long long end, int chunk) {
+        double start = begin * stepSize;
+        calculatePartialIntegral(start, end * stepSize, end - begin, stepSize, partials[chunk]);
+    });
+    double pi = 0.0;
+    for (double partial : partials) {
+        pi += partial;
+    }
+    return pi;
+}
+
+vector<double> integrateBatch(ThreadPool& pool, const vector<long long>& steps, int chunksPerIntegral) {
+    vector<double> results(steps.size(), 0.0);
+    int count = static_cast<int>(steps.size());
+    pool.parallelFor(count, count, [&](long long begin, long long end, int) {
+        for (long long i = begin; i < end; ++i) {
+            results[i] = integrateOnPool(pool, steps[i], chunksPerIntegral);
+        }
+    });
+    return results;
+}
+
+int runNestedMode(int argc, char* argv[]) {
+    long long steps = max(1LL, getIntOption(argc, argv, "--steps", 20000000));
+    int threadsPer = static_cast<int>(max(1LL, getIntOption(argc, argv, "--threads-per", 8)));
+    int maxBatch = static_cast<int>(max(1LL, getIntOption(argc, argv, "--max-batch", 16)));
+    int numThreads = static_cast<int>(getIntOption(argc, argv, "--threads", thread::hardware_concurrency()));
+
+    ThreadPool pool(static_cast<unsigned>(max(1, numThreads)));
+    cout << "Liczba kroków: " << steps << ", Wątki na całkowanie: " << threadsPer << ", Pula: " << pool.size() << endl;
+
+    bool consistent = true;
+    double reference = integrateOnPool(pool, steps, threadsPer);
+    for (int batch = 1; batch <= maxBatch; batch *= 2) {
+        // B jednoczesnych calculatePi() - każde tworzy własne wątki
+        auto startTime = chrono::high_resolution_clock::now();
+        vector<thread> callers;
+        for (int b = 0; b < batch; ++b) {
+            callers.emplace_back([&] { calculatePi(steps, threadsPer); });
+        }
+        for (auto& t : callers) {
+            t.join();
+        }
+        chrono::duration<double> spawned = chrono::high_resolution_clock::now() - startTime;
+
+        // Ten sam wsad na jednej puli z zagnieżdżonym parallelFor
+        startTime = chrono::high_resolution_clock::now();
+        vector<double> results = integrateBatch(pool, vector<long long>(batch, steps), threadsPer);
+        chrono::duration<double> nested = chrono::high_resolution_clock::now() - startTime;
+        for (double result : results) {
+            consistent = consistent && result == reference;
+        }
+
+        cout << "Wsad: " << batch
+            << ", Nowe wątki: " << batch * threadsPer << " wątków, " << batch / spawned.count() << " całkowań/s"
+            << ", Wspólna pula: " << pool.size() + 1 << " wątków, " << batch / nested.count() << " całkowań/s" << endl;
+    }
+    cout << "Wyniki zagnieżdżone zgodne: " << (consistent ? "tak" : "nie") << endl;
+    return consistent ? 0 : 1;
+}
@@ -0,0 +1,46 @@
+﻿/**
+ * @file BatchIntegration.h
+ * @brief Wsadowe całkowanie z zagnieżdżoną równoległością na jednej wspólnej puli.
+ *
+ * calculatePi() tworzy numThreads wątków przy każdym wywołaniu, więc B
+ * jednoczesnych całkowań uruchamia B·numThreads wątków - znacznie więcej niż
+ * rdzeni. Tutaj zarówno pętla po całkowaniach, jak i pętla po fragmentach
+ * każdego całkowania są zadaniami tej samej puli (ThreadPool::parallelFor()
+ * z pomocą w oczekiwaniu), więc liczba wątków jest stała niezależnie od
+ * rozmiaru wsadu.
+ */
+
+#pragma once
+
+#include <vector>
+
+class ThreadPool;
+
+/**
+ * @brief Liczba PI metodą prostokątów, fragmenty wykonywane jako zadania puli.
+ *
+ * Wyniki fragmentów sumowane są w ich kolejności, więc wynik nie zależy od
+ * liczby wątków ani od zagnieżdżenia.
+ *
+ * @param chunks Liczba fragmentów (poziom równoległości jednego całkowania).
+ */
+double integrateOnPool(ThreadPool& pool, long long steps, int chunks);
+
+/**
+ * @brief Wsad niezależnych całkowań - każde z nich jest równoległe (zagnieżdżony parallelFor).
+ */
+std::vector<double> integrateBatch(ThreadPool& pool, const std::vector<long long>& steps, int chunksPerIntegral);
+
+/**
+ * @brief Uruchamia tryb `nested` - przepustowość wsadów równoległych całkowań.
+ *
+ * Dla rozmiarów wsadu 1, 2, 4, ... `--max-batch` porównuje B jednoczesnych
+ * wywołań calculatePi() (każde z `--threads-per` nowymi wątkami) z wsadem
+ * wykonanym na jednej puli. Wypisuje liczbę wątków, przepustowość
+ * (całkowania/s) i zgodność wyników. Opcje: `--steps n` (domyślnie 2e7),
+ * `--threads-per n` (domyślnie 8), `--max-batch n` (domyślnie 16),
+ * `--threads n` (rozmiar puli, domyślnie liczba wątków sprzętowych).
+ *
+ * @return Kod zakończenia programu.
+ */
+int runNestedMode(int argc, char* argv[]);
@@ -0,0 +1,347 @@
+﻿/**
+ * @file BatchedOde.cpp
+ * @brief Implementacja wsadowej metody Dormanda-Prince'a z instancjami w liniach rejestrów SIMD.
+ */
+
+#include "BatchedOde.h"
+#include "CommandLine.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define PI_ODE_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PI_ODE_SSE2 1
+#endif
+
+using namespace std;
+
+namespace {
+
+/**
+ * @brief Jedna instancja na "rejestr" - wariant odniesienia i zapasowy bez SIMD.
+ */
+struct ScalarLanes {
+    static constexpr int width = 1;
+    double v;
+
+    static ScalarLanes load(const double* p) { return { *p }; }
+    static ScalarLanes broadcast(double x) { return { x }; }
+    void store(double* p) const { *p = v; }
+
+    friend ScalarLanes operator+(ScalarLanes a, ScalarLanes b) { return { a.v + b.v }; }
+    friend ScalarLanes operator-(ScalarLanes a, ScalarLanes b) { return { a.v - b.v }; }
+    friend ScalarLanes operator*(ScalarLanes a, ScalarLanes b) { return { a.v * b.v }; }
+    friend ScalarLanes operator/(ScalarLanes a, ScalarLanes b) { return { a.v / b.v }; }
+};
+
+#if defined(PI_ODE_AVX)
+/// Cztery instancje w rejestrze AVX.
+struct SimdLanes {
+    static constexpr int width = 4;
+    __m256d v;
+
+    static SimdLanes load(const double* p) { return { _mm256_loadu_pd(p) }; }
+    static SimdLanes broadcast(double x) { return { _mm256_set1_pd(x) }; }
+    void store(double* p) const { _mm256_storeu_pd(p, v); }
+
+    friend SimdLanes operator+(SimdLanes a, SimdLanes b) { return { _mm256_add_pd(a.v, b.v) }; }
+    friend SimdLanes operator-(SimdLanes a, SimdLanes b) { return { _mm256_sub_pd(a.v, b.v) }; }
+    friend SimdLanes operator*(SimdLanes a, SimdLanes b) { return { _mm256_mul_pd(a.v, b.v) }; }
+    friend SimdLanes operator/(SimdLanes a, SimdLanes b) { return { _mm256_div_pd(a.v, b.v) }; }
+};
+#elif defined(PI_ODE_SSE2)
+/// Dwie instancje w rejestrze SSE2.
+struct SimdLanes {
+    static constexpr int width = 2;
+    __m128d v;
+
+    static SimdLanes load(const double* p) { return { _mm_loadu_pd(p) }; }
+    static SimdLanes broadcast(double x) { return { _mm_set1_pd(x) }; }
+    void store(double* p) const { _mm_storeu_pd(p, v); }
+
+    friend SimdLanes operator+(SimdLanes a, SimdLanes b) { return { _mm_add_pd(a.v, b.v) }; }
+    friend SimdLanes operator-(SimdLanes a, SimdLanes b) { return { _mm_sub_pd(a.v, b.v) }; }
+    friend SimdLanes operator*(SimdLanes a, SimdLanes b) { return { _mm_mul_pd(a.v, b.v) }; }
+    friend SimdLanes operator/(SimdLanes a, SimdLanes b) { return { _mm_div_pd(a.v, b.v) }; }
+};
+#else
+using SimdLanes = ScalarLanes;
+#endif
+
+/// Prawa strona równania \p problem dla wszystkich linii naraz.
+template <typename Lanes>
+Lanes rightHandSide(OdeProblem problem, Lanes t, Lanes y, Lanes p) {
+    const Lanes one = Lanes::broadcast(1.0);
+    if (problem == OdeProblem::Logistic) {
+        return p * y * (one - y);
+    }
+    Lanes pt = p * t;
+    return Lanes::broadcast(4.0) * p / (one + pt * pt);
+}
+
+// Tablica Butchera metody Dormanda-Prince'a 5(4)
+constexpr double c2 = 1.0 / 5.0, c3 = 3.0 / 10.0, c4 = 4.0 / 5.0, c5 = 8.0 / 9.0;
+constexpr double a21 = 1.0 / 5.0;
+constexpr double a31 = 3.0 / 40.0, a32 = 9.0 / 40.0;
+constexpr double a41 = 44.0 / 45.0, a42 = -56.0 / 15.0, a43 = 32.0 / 9.0;
+constexpr double a51 = 19372.0 / 6561.0, a52 = -25360.0 / 2187.0, a53 = 64448.0 / 6561.0, a54 = -212.0 / 729.0;
+constexpr double a61 = 9017.0 / 3168.0, a62 = -355.0 / 33.0, a63 = 46732.0 / 5247.0, a64 = 49.0 / 176.0,
+    a65 = -5103.0 / 18656.0;
+constexpr double a71 = 35.0 / 384.0, a73 = 500.0 / 1113.0, a74 = 125.0 / 192.0, a75 = -2187.0 / 6784.0,
+    a76 = 11.0 / 84.0;
+
+// Różnica rozwiązań rzędu 5 i 4 (oszacowanie błędu lokalnego)
+constexpr double e1 = 71.0 / 57600.0, e3 = -71.0 / 16695.0, e4 = 71.0 / 1920.0, e5 = -17253.0 / 339200.0,
+    e6 = 22.0 / 525.0, e7 = -1.0 / 40.0;
+
+// Współczynniki interpolantu wyjścia gęstego (Hairer, Nørsett, Wanner)
+constexpr double d1 = -12715105075.0 / 11282082432.0, d3 = 87487479700.0 / 32700410799.0,
+    d4 = -10690763975.0 / 1880347072.0, d5 = 701980252875.0 / 199316789632.0,
+    d6 = -1453857185.0 / 822651844.0, d7 = 69997945.0 / 29380423.0;
+
+/// Stan wszystkich linii jednego rejestru; tablice zamiast wektorów SIMD, bo akceptacja jest per linia.
+template <int Width>
+struct LaneState {
+    double t[Width] = {};
+    double y[Width] = {};
+    double h[Width] = {};
+    double p[Width] = {};
+    double k[7][Width] = {}; ///< Etapy ostatniego kroku; k[0] to k1 (FSAL z k7 poprzedniego kroku).
+    double yNew[Width] = {};
+    double error[Width] = {};
+    long long instance[Width];   ///< Numer instancji lub −1 dla linii bezczynnej.
+    size_t nextOutput[Width] = {};
+};
+
+/// Wynik fragmentu instancji (liczniki sumowane po parallelFor).
+struct ChunkCounters {
+    long long accepted = 0;
+    long long rejected = 0;
+};
+
+/**
+ * @brief Rozwiązuje instancje [begin, end) wsadu, po Lanes::width naraz.
+ */
+template <typename Lanes>
+ChunkCounters solveChunk(const OdeBatch& batch, long long begin, long long end, OdeBatchResult& result) {
+    constexpr int width = Lanes::width;
+    const size_t outputs = batch.outputTimes.size();
+    const double span = batch.end - batch.start;
+    LaneState<width> s;
+    ChunkCounters counters;
+    long long next = begin;
+    bool needFirstStage = false;
+
+    // Przydziela linii następną instancję fragmentu (lub oznacza ją jako bezczynną)
+    auto loadLane = [&](int lane) {
+        if (next >= end) {
+            s.instance[lane] = -1;
+            s.h[lane] = 0.0;
+            return;
+        }
+        long long i = next++;
+        s.instance[lane] = i;
+        s.t[lane] = batch.start;
+        s.y[lane] = batch.initialValues[i];
+        s.p[lane] = batch.parameters[i];
+        s.h[lane] = span * 1e-3;
+        s.nextOutput[lane] = 0;
+        while (s.nextOutput[lane] < outputs && batch.outputTimes[s.nextOutput[lane]] <= batch.start) {
+            result.denseValues[i * outputs + s.nextOutput[lane]++] = s.y[lane];
+        }
+        needFirstStage = true;
+    };
+    for (int lane = 0; lane < width; ++lane) {
+        loadLane(lane);
+    }
+
+    const OdeProblem problem = batch.problem;
+    while (true) {
+        bool active = false;
+        for (int lane = 0; lane < width; ++lane) {
+            active = active || s.instance[lane] >= 0;
+        }
+        if (!active) {
+            break;
+        }
+
+        Lanes t = Lanes::load(s.t), y = Lanes::load(s.y), h = Lanes::load(s.h), p = Lanes::load(s.p);
+        if (needFirstStage) {
+            // Nowo załadowane linie nie mają k1 z poprzedniego kroku - liczone jest dla całego rejestru
+            rightHandSide(problem, t, y, p).store(s.k[0]);
+            needFirstStage = false;
+        }
+        auto B = [](double value) { return Lanes::broadcast(value); };
+        Lanes k1 = Lanes::load(s.k[0]);
+        Lanes k2 = rightHandSide(problem, t + B(c2) * h, y + h * (B(a21) * k1), p);
+        Lanes k3 = rightHandSide(problem, t + B(c3) * h, y + h * (B(a31) * k1 + B(a32) * k2), p);
+        Lanes k4 = rightHandSide(problem, t + B(c4) * h, y + h * (B(a41) * k1 + B(a42) * k2 + B(a43) * k3), p);
+        Lanes k5 = rightHandSide(problem, t + B(c5) * h,
+            y + h * (B(a51) * k1 + B(a52) * k2 + B(a53) * k3 + B(a54) * k4), p);
+        Lanes k6 = rightHandSide(problem, t + h,
+            y + h * (B(a61) * k1 + B(a62) * k2 + B(a63) * k3 + B(a64) * k4 + B(a65) * k5), p);
+        Lanes yNew = y + h * (B(a71) * k1 + B(a73) * k3 + B(a74) * k4 + B(a75) * k5 + B(a76) * k6);
+        Lanes k7 = rightHandSide(problem, t + h, yNew, p);
+        Lanes error = h * (B(e1) * k1 + B(e3) * k3 + B(e4) * k4 + B(e5) * k5 + B(e6) * k6 + B(e7) * k7);
+        k2.store(s.k[1]);
+        k3.store(s.k[2]);
+        k4.store(s.k[3]);
+        k5.store(s.k[4]);
+        k6.store(s.k[5]);
+        k7.store(s.k[6]);
+        yNew.store(s.yNew);
+        error.store(s.error);
+
+        // Akceptacja i nowy krok osobno w każdej linii
+        for (int lane = 0; lane < width; ++lane) {
+            long long i = s.instance[lane];
+            if (i < 0) {
+                continue;
+            }
+            double scale = batch.absoluteTolerance + batch.relativeTolerance * max(fabs(s.y[lane]), fabs(s.yNew[lane]));
+            double norm = fabs(s.error[lane]) / scale;
+            double step = s.h[lane];
+            if (norm <= 1.0) {
+                ++counters.accepted;
+                double tNew = s.t[lane] + step;
+                bool finished = tNew >= batch.end - 1e-14 * fabs(span);
+                if (finished) {
+                    tNew = batch.end;
+                }
+
+                // Wyjście gęste dla chwil z przedziału (t, t + h]
+                while (s.nextOutput[lane] < outputs && batch.outputTimes[s.nextOutput[lane]] <= tNew) {
+                    double theta = (batch.outputTimes[s.nextOutput[lane]] - s.t[lane]) / step;
+                    double r1 = s.y[lane];
+                    double r2 = s.yNew[lane] - s.y[lane];
+                    double r3 = step * s.k[0][lane] - r2;
+                    double r4 = r2 - step * s.k[6][lane] - r3;
+                    double r5 = step * (d1 * s.k[0][lane] + d3 * s.k[2][lane] + d4 * s.k[3][lane]
+                        + d5 * s.k[4][lane] + d6 * s.k[5][lane] + d7 * s.k[6][lane]);
+                    result.denseValues[i * outputs + s.nextOutput[lane]++] =
+                        r1 + theta * (r2 + (1.0 - theta) * (r3 + theta * (r4 + (1.0 - theta) * r5)));
+                }
+
+                s.t[lane] = tNew;
+                s.y[lane] = s.yNew[lane];
+                s.k[0][lane] = s.k[6][lane];
+                if (finished) {
+                    result.finalValues[i] = s.y[lane];
+                    loadLane(lane);
+                    continue;
+                }
+            }
+            else {
+                ++counters.rejected;
+            }
+            double factor = norm > 0.0 ? 0.9 * pow(norm, -0.2) : 5.0;
+            factor = min(norm <= 1.0 ? 5.0 : 1.0, max(0.2, factor));
+            s.h[lane] = min(step * factor, batch.end - s.t[lane]);
+        }
+    }
+    return counters;
+}
+
+} // namespace
+
+double exactOdeSolution(OdeProblem problem, double parameter, double initialValue, double start, double t) {
+    if (problem == OdeProblem::Logistic) {
+        return 1.0 / (1.0 + (1.0 / initialValue - 1.0) * exp(-parameter * (t - start)));
+    }
+    return initialValue + 4.0 * (atan(parameter * t) - atan(parameter * start));
+}
+
+OdeBatchResult solveOdeBatch(const OdeBatch& batch, ThreadPool& pool) {
+    long long instances = static_cast<long long>(batch.parameters.size());
+    OdeBatchResult result;
+    result.finalValues.assign(instances, 0.0);
+    result.denseValues.assign(instances * batch.outputTimes.size(), 0.0);
+    result.lanes = batch.vectorized ? SimdLanes::width : ScalarLanes::width;
+    if (instances == 0) {
+        return result;
+    }
+
+    int chunks = static_cast<int>(min<long long>(instances, pool.size() * 8));
+    vector<ChunkCounters> counters(chunks);
+    pool.parallelFor(instances, chunks, [&](long long begin, long long end, int chunk) {
+        counters[chunk] = batch.vectorized ? solveChunk<SimdLanes>(batch, begin, end, result)
+                                           : solveChunk<ScalarLanes>(batch, begin, end, result);
+    });
+    for (const ChunkCounters& chunk : counters) {
+        result.acceptedSteps += chunk.accepted;
+        result.rejectedSteps += chunk.rejected;
+    }
+    return result;
+}
+
+int runOdeMode(int argc, char* argv[]) {
+    string problemName = getOption(argc, argv, "--problem", "pi");
+    long long instances = max(1LL, getIntOption(argc, argv, "--instances", 10000));
+    double spread = getDoubleOption(argc, argv, "--spread", 20.0);
+    int outputs = static_cast<int>(max(0LL, getIntOption(argc, argv, "--outputs", 11)));
+    int numThreads = static_cast<int>(getIntOption(argc, argv, "--threads", thread::hardware_concurrency()));
+
+    OdeBatch batch;
+    batch.relativeTolerance = getDoubleOption(argc, argv, "--rtol", batch.relativeTolerance);
+    batch.absoluteTolerance = getDoubleOption(argc, argv, "--atol", batch.absoluteTolerance);
+    if (problemName == "pi") {
+        batch.problem = OdeProblem::Pi;
+    }
+    else if (problemName == "logistic") {
+        batch.problem = OdeProblem::Logistic;
+        batch.end = 10.0;
+    }
+    else {
+        cerr << "Nieznane równanie: " << problemName << endl;
+        return 1;
+    }
+
+    // Parametry rozłożone geometrycznie od 1 do spread - instancje wymagają różnej liczby kroków
+    for (long long i = 0; i < instances; ++i) {
+        double fraction = instances > 1 ? static_cast<double>(i) / static_cast<double>(instances - 1) : 0.0;
+        batch.parameters.push_back(pow(spread, fraction));
+        batch.initialValues.push_back(batch.problem == OdeProblem::Pi ? 0.0 : 0.01);
+    }
+    for (int j = 0; j < outputs; ++j) {
+        batch.outputTimes.push_back(batch.start + (batch.end - batch.start) * j / max(1, outputs - 1));
+    }
+
+    ThreadPool pool(static_cast<unsigned>(max(1, numThreads)));
+    cout << "Równanie: " << problemName << ", Instancje: " << instances << ", Wątki: " << pool.size() << endl;
+
+    for (bool vectorized : { true, false }) {
+        batch.vectorized = vectorized;
+        auto startTime = chrono::high_resolution_clock::now();
+        OdeBatchResult result = solveOdeBatch(batch, pool);
+        chrono::duration<double> duration = chrono::high_resolution_clock::now() - startTime;
+
+        double finalError = 0.0, denseError = 0.0;
+        for (long long i = 0; i < instances; ++i) {
+            double p = batch.parameters[i], y0 = batch.initialValues[i];
+            finalError = max(finalError,
+                fabs(result.finalValues[i] - exactOdeSolution(batch.problem, p, y0, batch.start, batch.end)));
+            for (int j = 0; j < outputs; ++j) {
+                double exact = exactOdeSolution(batch.problem, p, y0, batch.start, batch.outputTimes[j]);
+                denseError = max(denseError, fabs(result.denseValues[i * outputs + j] - exact));
+            }
+        }
+        cout << "Linie SIMD: " << result.lanes << ", Czas: " << duration.count()
+            << "s, Instancje/s: " << instances / duration.count()
+            << ", Kroki: " << result.acceptedSteps << " (odrzucone: " << result.rejectedSteps << ")"
+            << ", Maks. błąd końcowy: " << setprecision(3) << finalError
+            << ", Maks. błąd wyjścia gęstego: " << denseError << setprecision(6) << endl;
+        if (batch.problem == OdeProblem::Pi) {
+            cout << "PI (instancja 0): " << setprecision(15) << result.finalValues[0] << setprecision(6) << endl;
+        }
+    }
+    return 0;
+}
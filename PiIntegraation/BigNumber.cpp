@@ -0,0 +1,600 @@
+﻿/**
+ * @file BigNumber.cpp
+ * @brief Implementacja arytmetyki dowolnej precyzji (podstawa 10^9).
+ */
+
+#include "BigNumber.h"
+#include "CommandLine.h"
+#include "NttMultiply.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <sstream>
+
+using namespace std;
+
+namespace {
+
+/// Progi kaskady mnożenia (liczba limbów krótszego czynnika), zmierzone trybem `bigmul`.
+constexpr size_t karatsubaThreshold = 40;
+constexpr size_t toomThreshold = 250;
+#if defined(__AVX2__)
+constexpr size_t nttThreshold = 1500; // Wektorowe mnożenia Montgomery'ego w NTT
+#else
+constexpr size_t nttThreshold = 6000;
+#endif
+
+/// Od tej liczby limbów iloczyny częściowe Karacuby i Tooma-3 są liczone równolegle.
+constexpr size_t parallelThreshold = 2000;
+
+/// Liczba poziomów rekurencji, na których tworzone są zadania równoległe.
+constexpr int parallelDepth = 2;
+
+Limbs multiplyDispatch(const Limbs& a, const Limbs& b, MultiplyAlgorithm algorithm, ThreadPool* pool, int depth);
+
+Limbs schoolbookMultiply(const Limbs& a, const Limbs& b) {
+    Limbs result(a.size() + b.size(), 0);
+    for (size_t i = 0; i < a.size(); ++i) {
+        uint64_t factor = a[i];
+        if (factor == 0) {
+            continue;
+        }
+        uint64_t carry = 0;
+        for (size_t j = 0; j < b.size(); ++j) {
+            uint64_t current = result[i + j] + factor * b[j] + carry;
+            result[i + j] = static_cast<uint32_t>(current % limbBase);
+            carry = current / limbBase;
+        }
+        for (size_t k = i + b.size(); carry != 0; ++k) {
+            uint64_t current = result[k] + carry;
+            result[k] = static_cast<uint32_t>(current % limbBase);
+            carry = current / limbBase;
+        }
+    }
+    trimLimbs(result);
+    return result;
+}
+
+/// Dodaje \p value przesunięte o \p shift limbów do \p result (result musi być dostatecznie długi).
+void addShifted(Limbs& result, const Limbs& value, size_t shift) {
+    uint32_t carry = 0;
+    size_t i = 0;
+    for (; i < value.size() || carry != 0; ++i) {
+        uint32_t sum = result[shift + i] + carry + (i < value.size() ? value[i] : 0);
+        carry = sum >= limbBase ? 1 : 0;
+        result[shift + i] = sum - carry * limbBase;
+    }
+}
+
+Limbs slice(const Limbs& value, size_t begin, size_t end) {
+    begin = min(begin, value.size());
+    end = min(end, value.size());
+    Limbs part(value.begin() + begin, value.begin() + end);
+    trimLimbs(part);
+    return part;
+}
+
+/**
+ * @brief Wykonuje \p count niezależnych iloczynów częściowych.
+ *
+ * Na najwyższych poziomach rekurencji (i dla dużych czynników) iloczyny
+ * trafiają do puli wątków, niżej są liczone po kolei.
+ */
+template <typename Compute>
+void runProducts(int count, Compute compute, ThreadPool* pool, int depth, size_t size) {
+    if (pool != nullptr && depth < parallelDepth && size >= parallelThreshold) {
+        pool->parallelFor(count, count, [&](long long begin, long long, int) { compute(static_cast<int>(begin)); });
+        return;
+    }
+    for (int i = 0; i < count; ++i) {
+        compute(i);
+    }
+}
+
+Limbs karatsuba(const Limbs& a, const Limbs& b, ThreadPool* pool, int depth) {
+    size_t half = max(a.size(), b.size()) / 2;
+    Limbs a0 = slice(a, 0, half), a1 = slice(a, half, a.size());
+    Limbs b0 = slice(b, 0, half), b1 = slice(b, half, b.size());
+    Limbs sumA = addLimbs(a0, a1), sumB = addLimbs(b0, b1);
+
+    // z0 = a0·b0, z1 = (a0 + a1)(b0 + b1), z2 = a1·b1
+    Limbs products[3];
+    const Limbs* left[3] = { &a0, &sumA, &a1 };
+    const Limbs* right[3] = { &b0, &sumB, &b1 };
+    runProducts(3, [&](int i) {
+        products[i] = multiplyDispatch(*left[i], *right[i], MultiplyAlgorithm::Automatic, pool, depth + 1);
+    }, pool, depth, min(a.size(), b.size()));
+
+    Limbs middle = subtractLimbs(subtractLimbs(products[1], products[0]), products[2]);
+    Limbs result(a.size() + b.size() + 1, 0);
+    addShifted(result, products[0], 0);
+    addShifted(result, middle, half);
+    addShifted(result, products[2], 2 * half);
+    trimLimbs(result);
+    return result;
+}
+
+/**
+ * @brief Liczba całkowita ze znakiem - potrzebna tylko w interpolacji Tooma-3.
+ */
+struct SignedLimbs {
+    Limbs magnitude;
+    bool negative = false;
+};
+
+SignedLimbs signedAdd(const SignedLimbs& a, const SignedLimbs& b) {
+    SignedLimbs result;
+    if (a.negative == b.negative) {
+        result.magnitude = addLimbs(a.magnitude, b.magnitude);
+        result.negative = a.negative;
+    }
+    else if (compareLimbs(a.magnitude, b.magnitude) >= 0) {
+        result.magnitude = subtractLimbs(a.magnitude, b.magnitude);
+        result.negative = a.negative;
+    }
+    else {
+        result.magnitude = subtractLimbs(b.magnitude, a.magnitude);
+        result.negative = b.negative;
+    }
+    result.negative = result.negative && !result.magnitude.empty();
+    return result;
+}
+
+SignedLimbs signedSubtract(const SignedLimbs& a, SignedLimbs b) {
+    b.negative = !b.negative && !b.magnitude.empty();
+    return signedAdd(a, b);
+}
+
+SignedLimbs signedScale(const SignedLimbs& a, uint32_t factor) {
+    return { multiplyLimbsSmall(a.magnitude, factor), a.negative };
+}
+
+/// Dzielenie dokładne (reszta zawsze równa zero w interpolacji Tooma-3).
+SignedLimbs signedDivideExact(const SignedLimbs& a, uint32_t divisor) {
+    return { divideLimbsSmall(a.magnitude, divisor), a.negative };
+}
+
+/**
+ * @brief Algorytm Tooma-Cooka 3: pięć iloczynów o rozmiarze n/3 zamiast dziewięciu.
+ *
+ * Wielomiany są wartościowane w punktach 0, 1, −1, −2 i ∞, a współczynniki
+ * iloczynu odtwarzane sekwencją interpolacji Bodrato.
+ */
+Limbs toom3(const Limbs& a, const Limbs& b, ThreadPool* pool, int depth) {
+    size_t part = (max(a.size(), b.size()) + 2) / 3;
+    SignedLimbs x[3] = { { slice(a, 0, part) }, { slice(a, part, 2 * part) }, { slice(a, 2 * part, a.size()) } };
+    SignedLimbs y[3] = { { slice(b, 0, part) }, { slice(b, part, 2 * part) }, { slice(b, 2 * part, b.size()) } };
+
+    // Wartości w punktach 0, 1, −1, −2, ∞
+    auto evaluate = [](const SignedLimbs* c, SignedLimbs* values) {
+        SignedLimbs outer = signedAdd(c[0], c[2]);
+        values[0] = c[0];
+        values[1] = signedAdd(outer, c[1]);
+        values[2] = signedSubtract(outer, c[1]);
+        values[3] = signedSubtract(signedScale(signedAdd(values[2], c[2]), 2), c[0]);
+        values[4] = c[2];
+    };
+    SignedLimbs px[5], py[5], r[5];
+    evaluate(x, px);
+    evaluate(y, py);
+    runProducts(5, [&](int i) {
+        r[i].magnitude = multiplyDispatch(px[i].magnitude, py[i].magnitude, MultiplyAlgorithm::Automatic, pool, depth + 1);
+        r[i].negative = px[i].negative != py[i].negative && !r[i].magnitude.empty();
+    }, pool, depth, min(a.size(), b.size()));
+
+    // Interpolacja: r[0] = r(0), r[1] = r(1), r[2] = r(−1), r[3] = r(−2), r[4] = r(∞)
+    SignedLimbs c3 = signedDivideExact(signedSubtract(r[3], r[1]), 3);
+    SignedLimbs c1 = signedDivideExact(signedSubtract(r[1], r[2]), 2);
+    SignedLimbs c2 = signedSubtract(r[2], r[0]);
+    c3 = signedAdd(signedDivideExact(signedSubtract(c2, c3), 2), signedScale(r[4], 2));
+    c2 = signedSubtract(signedAdd(c2, c1), r[4]);
+    c1 = signedSubtract(c1, c3);
+
+    // Współczynniki iloczynu liczb nieujemnych są nieujemne
+    Limbs result(a.size() + b.size() + 2, 0);
+    addShifted(result, r[0].magnitude, 0);
+    addShifted(result, c1.magnitude, part);
+    addShifted(result, c2.magnitude, 2 * part);
+    addShifted(result, c3.magnitude, 3 * part);
+    addShifted(result, r[4].magnitude, 4 * part);
+    trimLimbs(result);
+    return result;
+}
+
+/// Czynnik znacznie dłuższy od drugiego dzielony jest na kawałki o długości krótszego.
+Limbs unbalancedMultiply(const Limbs& longer, const Limbs& shorter, ThreadPool* pool, int depth) {
+    Limbs result(longer.size() + shorter.size() + 1, 0);
+    for (size_t offset = 0; offset < longer.size(); offset += shorter.size()) {
+        Limbs piece = slice(longer, offset, offset + shorter.size());
+        addShifted(result, multiplyDispatch(piece, shorter, MultiplyAlgorithm::Automatic, pool, depth), offset);
+    }
+    trimLimbs(result);
+    return result;
+}
+
+Limbs multiplyDispatch(const Limbs& a, const Limbs& b, MultiplyAlgorithm algorithm, ThreadPool* pool, int depth) {
+    if (a.empty() || b.empty()) {
+        return Limbs();
+    }
+    size_t shorter = min(a.size(), b.size());
+    size_t longer = max(a.size(), b.size());
+    if (algorithm == MultiplyAlgorithm::Automatic) {
+        if (shorter < karatsubaThreshold) {
+            algorithm = MultiplyAlgorithm::Schoolbook;
+        }
+        else if (longer >= 2 * shorter) {
+            return a.size() >= b.size() ? unbalancedMultiply(a, b, pool, depth) : unbalancedMultiply(b, a, pool, depth);
+        }
+        else if (shorter < toomThreshold) {
+            algorithm = MultiplyAlgorithm::Karatsuba;
+        }
+        else if (shorter < nttThreshold || a.size() + b.size() > maxNttProductLimbs) {
+            algorithm = MultiplyAlgorithm::Toom3;
+        }
+        else {
+            algorithm = MultiplyAlgorithm::Ntt;
+        }
+    }
+
+    switch (algorithm) {
+    case MultiplyAlgorithm::Karatsuba:
+        return karatsuba(a, b, pool, depth);
+    case MultiplyAlgorithm::Toom3:
+        return toom3(a, b, pool, depth);
+    case MultiplyAlgorithm::Ntt:
+        return nttMultiply(a, b, depth < parallelDepth ? pool : nullptr);
+    default:
+        return schoolbookMultiply(a, b);
+    }
+}
+
+} // namespace
+
+void trimLimbs(Limbs& value) {
+    while (!value.empty() && value.back() == 0) {
+        value.pop_back();
+    }
+}
+
+int compareLimbs(const Limbs& a, const Limbs& b) {
+    // Porównanie ignoruje zera wiodące
+    size_t sizeA = a.size(), sizeB = b.size();
+    while (sizeA > 0 && a[sizeA - 1] == 0) {
+        --sizeA;
+    }
+    while (sizeB > 0 && b[sizeB - 1] == 0) {
+        --sizeB;
+    }
+    if (sizeA != sizeB) {
+        return sizeA < sizeB ? -1 : 1;
+    }
+    for (size_t i = sizeA; i-- > 0;) {
+        if (a[i] != b[i]) {
+            return a[i] < b[i] ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+Limbs addLimbs(const Limbs& a, const Limbs& b) {
+    const Limbs& longer = a.size() >= b.size() ? a : b;
+    const Limbs& shorter = a.size() >= b.size() ? b : a;
+    Limbs result(longer.size() + 1, 0);
+    uint32_t carry = 0;
+    for (size_t i = 0; i < longer.size(); ++i) {
+        uint32_t sum = longer[i] + carry + (i < shorter.size() ? shorter[i] : 0);
+        carry = sum >= limbBase ? 1 : 0;
+        result[i] = sum - carry * limbBase;
+    }
+    result[longer.size()] = carry;
+    trimLimbs(result);
+    return result;
+}
+
+Limbs subtractLimbs(const Limbs& a, const Limbs& b) {
+    Limbs result(a.size(), 0);
+    int64_t borrow = 0;
+    for (size_t i = 0; i < a.size(); ++i) {
+        int64_t difference = static_cast<int64_t>(a[i]) - borrow - (i < b.size() ? b[i] : 0);
+        borrow = difference < 0 ? 1 : 0;
+        result[i] = static_cast<uint32_t>(difference + borrow * limbBase);
+    }
+    trimLimbs(result);
+    return result;
+}
+
+Limbs multiplyLimbsSmall(const Limbs& a, uint32_t factor) {
+    Limbs result(a.size() + 1, 0);
+    uint64_t carry = 0;
+    for (size_t i = 0; i < a.size(); ++i) {
+        uint64_t current = static_cast<uint64_t>(a[i]) * factor + carry;
+        result[i] = static_cast<uint32_t>(current % limbBase);
+        carry = current / limbBase;
+    }
+    result[a.size()] = static_cast<uint32_t>(carry);
+    trimLimbs(result);
+    return result;
+}
+
+Limbs divideLimbsSmall(const Limbs& a, uint32_t divisor) {
+    Limbs result(a.size(), 0);
+    uint64_t remainder = 0;
+    for (size_t i = a.size(); i-- > 0;) {
+        uint64_t current = remainder * limbBase + a[i];
+        result[i] = static_cast<uint32_t>(current / divisor);
+        remainder = current % divisor;
+    }
+    trimLimbs(result);
+    return result;
+}
+
+Limbs multiplyLimbs(const Limbs& a, const Limbs& b, ThreadPool* pool) {
+    return multiplyDispatch(a, b, MultiplyAlgorithm::Automatic, pool, 0);
+}
+
+Limbs multiplyLimbsWith(const Limbs& a, const Limbs& b, MultiplyAlgorithm algorithm, ThreadPool* pool) {
+    return multiplyDispatch(a, b, algorithm, pool, 0);
+}
+
+FixedPoint::FixedPoint(int precision) : fractionLimbs(precision) {
+}
+
+FixedPoint FixedPoint::fromInteger(uint32_t value, int precision) {
+    FixedPoint result(precision);
+    if (value != 0) {
+        result.mantissa.assign(precision, 0);
+        result.mantissa.push_back(value % limbBase);
+        if (value >= limbBase) {
+            result.mantissa.push_back(value / limbBase);
+        }
+    }
+    return result;
+}
+
+FixedPoint FixedPoint::fromDouble(double value, int precision) {
+    // Część całkowita i dwa limby części ułamkowej - więcej double nie przechowuje
+    FixedPoint result(precision);
+    double integer = floor(value);
+    double fraction = value - integer;
+    Limbs mantissa(precision, 0);
+    for (int i = precision - 1; i >= max(0, precision - 2); --i) {
+        fraction *= limbBase;
+        double limb = floor(fraction);
+        mantissa[i] = static_cast<uint32_t>(limb);
+        fraction -= limb;
+    }
+    for (uint64_t whole = static_cast<uint64_t>(integer); whole != 0; whole /= limbBase) {
+        mantissa.push_back(static_cast<uint32_t>(whole % limbBase));
+    }
+    trimLimbs(mantissa);
+    result.mantissa = std::move(mantissa);
+    return result;
+}
+
+FixedPoint FixedPoint::withPrecision(int precision) const {
+    FixedPoint result(precision);
+    if (precision >= fractionLimbs) {
+        result.mantissa.assign(precision - fractionLimbs, 0);
+        result.mantissa.insert(result.mantissa.end(), mantissa.begin(), mantissa.end());
+    }
+    else if (mantissa.size() > static_cast<size_t>(fractionLimbs - precision)) {
+        result.mantissa.assign(mantissa.begin() + (fractionLimbs - precision), mantissa.end());
+    }
+    trimLimbs(result.mantissa);
+    return result;
+}
+
+double FixedPoint::toDouble() const {
+    double value = 0.0;
+    // Wystarczą trzy najbardziej znaczące limby
+    size_t first = mantissa.size() > 3 ? mantissa.size() - 3 : 0;
+    for (size_t i = mantissa.size(); i-- > first;) {
+        double exponent = static_cast<double>(i) - static_cast<double>(fractionLimbs);
+        value += mantissa[i] * pow(static_cast<double>(limbBase), exponent);
+    }
+    return value;
+}
+
+string FixedPoint::toDecimal(int digits) const {
+    // Część całkowita
+    Limbs integer;
+    if (mantissa.size() > static_cast<size_t>(fractionLimbs)) {
+        integer.assign(mantissa.begin() + fractionLimbs, mantissa.end());
+    }
+    string text;
+    char buffer[16];
+    if (integer.empty()) {
+        text = "0";
+    }
+    else {
+        snprintf(buffer, sizeof(buffer), "%u", integer.back());
+        text = buffer;
+        for (size_t i = integer.size() - 1; i-- > 0;) {
+            snprintf(buffer, sizeof(buffer), "%09u", integer[i]);
+            text += buffer;
+        }
+    }
+
+    // Część ułamkowa od najbardziej znaczącego limbu
+    text += '.';
+    string fraction;
+    for (int i = fractionLimbs - 1; i >= 0 && static_cast<int>(fraction.size()) < digits; --i) {
+        uint32_t limb = static_cast<size_t>(i) < mantissa.size() ? mantissa[i] : 0;
+        snprintf(buffer, sizeof(buffer), "%09u", limb);
+        fraction += buffer;
+    }
+    fraction.resize(static_cast<size_t>(digits), '0');
+    return text + fraction;
+}
+
+bool FixedPoint::isBelow(int limbs) const {
+    // Wartość < 10^(−9·limbs) <=> wszystkie limby od pozycji fractionLimbs − limbs w górę są zerowe
+    size_t first = static_cast<size_t>(max(0, fractionLimbs - limbs));
+    for (size_t i = first; i < mantissa.size(); ++i) {
+        if (mantissa[i] != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+FixedPoint operator+(const FixedPoint& a, const FixedPoint& b) {
+    FixedPoint result(a.fractionLimbs);
+    result.mantissa = addLimbs(a.mantissa, b.mantissa);
+    return result;
+}
+
+FixedPoint operator-(const FixedPoint& a, const FixedPoint& b) {
+    FixedPoint result(a.fractionLimbs);
+    result.mantissa = subtractLimbs(a.mantissa, b.mantissa);
+    return result;
+}
+
+FixedPoint absoluteDifference(const FixedPoint& a, const FixedPoint& b) {
+    return b < a ? a - b : b - a;
+}
+
+FixedPoint multiply(const FixedPoint& a, const FixedPoint& b, ThreadPool* pool) {
+    // Iloczyn ma 2·precyzja limbów ułamkowych - młodsze limby są odrzucane
+    FixedPoint result(a.fractionLimbs);
+    Limbs product = multiplyLimbs(a.mantissa, b.mantissa, pool);
+    if (product.size() > static_cast<size_t>(b.fractionLimbs)) {
+        result.mantissa.assign(product.begin() + b.fractionLimbs, product.end());
+    }
+    return result;
+}
+
+FixedPoint multiplySmall(const FixedPoint& a, uint32_t factor) {
+    FixedPoint result(a.fractionLimbs);
+    result.mantissa = multiplyLimbsSmall(a.mantissa, factor);
+    return result;
+}
+
+FixedPoint divideSmall(const FixedPoint& a, uint32_t divisor) {
+    FixedPoint result(a.fractionLimbs);
+    result.mantissa = divideLimbsSmall(a.mantissa, divisor);
+    return result;
+}
+
+namespace {
+
+/**
+ * @brief Kolejne precyzje iteracji Newtona: każda około dwa razy większa od poprzedniej.
+ *
+ * Metoda Newtona podwaja liczbę poprawnych cyfr, więc wcześniejsze iteracje
+ * mogą być liczone z mniejszą precyzją - łączny koszt to kilka mnożeń
+ * w pełnej precyzji.
+ */
+vector<int> newtonPrecisions(int precision) {
+    vector<int> levels = { precision };
+    while (levels.back() > 3) {
+        levels.push_back(levels.back() / 2 + 1);
+    }
+    reverse(levels.begin(), levels.end());
+    levels.push_back(precision); // Końcowa iteracja poprawiająca ostatnie limby
+    return levels;
+}
+
+} // namespace
+
+FixedPoint inverseSqrt(const FixedPoint& a, ThreadPool* pool) {
+    vector<int> levels = newtonPrecisions(a.precision());
+    FixedPoint y = FixedPoint::fromDouble(1.0 / sqrt(a.toDouble()), levels.front());
+    for (int precision : levels) {
+        // y ← y + y·(1 − a·y²)/2
+        FixedPoint aAtPrecision = a.withPrecision(precision);
+        y = y.withPrecision(precision);
+        FixedPoint one = FixedPoint::fromInteger(1, precision);
+        FixedPoint error = multiply(multiply(y, y, pool), aAtPrecision, pool);
+        FixedPoint correction = divideSmall(multiply(y, absoluteDifference(one, error), pool), 2);
+        y = error < one ? y + correction : y - correction;
+    }
+    return y;
+}
+
+FixedPoint squareRoot(const FixedPoint& a, ThreadPool* pool) {
+    // s = a·(1/√a), następnie s ← s + (a − s²)·(1/√a)/2
+    FixedPoint y = inverseSqrt(a, pool);
+    FixedPoint s = multiply(a, y, pool);
+    FixedPoint square = multiply(s, s, pool);
+    FixedPoint correction = divideSmall(multiply(y, absoluteDifference(a, square), pool), 2);
+    return square < a ? s + correction : s - correction;
+}
+
+FixedPoint divide(const FixedPoint& a, const FixedPoint& b, ThreadPool* pool) {
+    vector<int> levels = newtonPrecisions(b.precision());
+    FixedPoint y = FixedPoint::fromDouble(1.0 / b.toDouble(), levels.front());
+    for (int precision : levels) {
+        // y ← y + y·(1 − b·y)
+        FixedPoint bAtPrecision = b.withPrecision(precision);
+        y = y.withPrecision(precision);
+        FixedPoint one = FixedPoint::fromInteger(1, precision);
+        FixedPoint error = multiply(bAtPrecision, y, pool);
+        FixedPoint correction = multiply(y, absoluteDifference(one, error), pool);
+        y = error < one ? y + correction : y - correction;
+    }
+    return multiply(a, y, pool);
+}
+
+int runMultiplyBenchmark(int argc, char* argv[]) {
+    string sizesList = getOption(argc, argv, "--limbs", "32,64,128,256,512,1024,4096,16384,65536");
+    int numThreads = static_cast<int>(getIntOption(argc, argv, "--threads", 1));
+    ThreadPool pool(static_cast<unsigned>(max(1, numThreads)));
+    ThreadPool* poolPointer = numThreads > 1 ? &pool : nullptr;
+
+    struct Algorithm {
+        const char* name;
+        MultiplyAlgorithm algorithm;
+        size_t maxLimbs; ///< Powyżej tego rozmiaru pomiar trwałby zbyt długo.
+    };
+    const Algorithm algorithms[] = {
+        { "szkolna", MultiplyAlgorithm::Schoolbook, 20000 },
+        { "Karacuba", MultiplyAlgorithm::Karatsuba, 1000000 },
+        { "Toom-3", MultiplyAlgorithm::Toom3, 1000000 },
+        { "NTT", MultiplyAlgorithm::Ntt, maxNttProductLimbs / 2 },
+        { "kaskada", MultiplyAlgorithm::Automatic, maxNttProductLimbs },
+    };
+
+    mt19937 generator(12345);
+    uniform_int_distribution<uint32_t> limb(0, limbBase - 1);
+    stringstream stream(sizesList);
+    for (string item; getline(stream, item, ',');) {
+        size_t size = static_cast<size_t>(stod(item));
+        Limbs a(size), b(size);
+        for (size_t i = 0; i < size; ++i) {
+            a[i] = limb(generator);
+            b[i] = limb(generator);
+        }
+        a.back() = b.back() = 1;
+
+        Limbs reference;
+        for (const Algorithm& algorithm : algorithms) {
+            if (size > algorithm.maxLimbs) {
+                continue;
+            }
+            // Powtórzenia aż do co najmniej 0,2 s, aby zmierzyć także małe rozmiary
+            Limbs product;
+            int repetitions = 0;
+            auto startTime = chrono::high_resolution_clock::now();
+            chrono::duration<double> duration;
+            do {
+                product = multiplyLimbsWith(a, b, algorithm.algorithm, poolPointer);
+                ++repetitions;
+                duration = chrono::high_resolution_clock::now() - startTime;
+            } while (duration.count() < 0.2);
+
+            if (reference.empty()) {
+                reference = product;
+            }
+            cout << "Limby: " << size << ", Algorytm: " << algorithm.name
+                << ", Czas: " << duration.count() / repetitions << "s"
+                << (product == reference ? "" : ", BŁĘDNY WYNIK") << endl;
+        }
+    }
+    return 0;
+}
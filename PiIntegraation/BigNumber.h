@@ -0,0 +1,150 @@
+﻿/**
+ * @file BigNumber.h
+ * @brief Arytmetyka dowolnej precyzji dla silników obliczających cyfry liczby PI.
+ *
+ * Liczby przechowywane są jako tablice "cyfr" (limbów) o podstawie 10^9,
+ * od najmniej znaczącej. Podstawa dziesiętna pozwala wypisać wynik bez
+ * kosztownej konwersji. Liczby stałoprzecinkowe (FixedPoint) mają zadaną
+ * liczbę limbów części ułamkowej.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class ThreadPool;
+
+/// Tablica limbów o podstawie limbBase, od najmniej znaczącego.
+using Limbs = std::vector<std::uint32_t>;
+
+/// Podstawa pojedynczego limbu (9 cyfr dziesiętnych).
+constexpr std::uint32_t limbBase = 1000000000;
+
+/// Liczba cyfr dziesiętnych w jednym limbie.
+constexpr int limbDigits = 9;
+
+/// Usuwa zera wiodące (najbardziej znaczące limby równe zero).
+void trimLimbs(Limbs& value);
+
+/// Porównuje dwie liczby naturalne: wynik < 0, 0 lub > 0.
+int compareLimbs(const Limbs& a, const Limbs& b);
+
+/// Suma dwóch liczb naturalnych.
+Limbs addLimbs(const Limbs& a, const Limbs& b);
+
+/// Różnica a − b dla a ≥ b.
+Limbs subtractLimbs(const Limbs& a, const Limbs& b);
+
+/// Iloczyn przez liczbę mniejszą od limbBase.
+Limbs multiplyLimbsSmall(const Limbs& a, std::uint32_t factor);
+
+/// Iloraz przez liczbę mniejszą od limbBase (reszta jest odrzucana).
+Limbs divideLimbsSmall(const Limbs& a, std::uint32_t divisor);
+
+/**
+ * @brief Algorytmy mnożenia dużych liczb, od najprostszego do asymptotycznie najszybszego.
+ */
+enum class MultiplyAlgorithm {
+    Automatic,  ///< Kaskada wybierana według progów z BigNumber.cpp.
+    Schoolbook, ///< Metoda szkolna, O(n²).
+    Karatsuba,  ///< Algorytm Karacuby, O(n^1,585).
+    Toom3,      ///< Algorytm Tooma-Cooka 3, O(n^1,465).
+    Ntt,        ///< Transformata teorioliczbowa, O(n log n) (NttMultiply.h).
+};
+
+/**
+ * @brief Iloczyn dwóch liczb naturalnych.
+ *
+ * Algorytm wybierany jest kaskadowo według rozmiaru krótszego czynnika:
+ * metoda szkolna, Karacuba, Toom-3, NTT. Progi przejścia zostały dobrane
+ * pomiarami trybu `bigmul`. Jeśli podano pulę wątków, iloczyny częściowe
+ * najwyższych poziomów rekurencji (oraz etapy NTT) wykonywane są równolegle.
+ *
+ * @param a Pierwszy czynnik.
+ * @param b Drugi czynnik.
+ * @param pool Pula wątków lub nullptr dla obliczeń sekwencyjnych.
+ */
+Limbs multiplyLimbs(const Limbs& a, const Limbs& b, ThreadPool* pool = nullptr);
+
+/**
+ * @brief Iloczyn z wymuszonym algorytmem na najwyższym poziomie rekurencji.
+ *
+ * Iloczyny częściowe korzystają już z kaskady automatycznej. Służy do
+ * porównywania algorytmów i strojenia progów kaskady.
+ */
+Limbs multiplyLimbsWith(const Limbs& a, const Limbs& b, MultiplyAlgorithm algorithm, ThreadPool* pool = nullptr);
+
+/**
+ * @brief Uruchamia tryb `bigmul` - pomiar czasu mnożenia każdym algorytmem.
+ *
+ * Opcje: `--limbs n[,n...]` (rozmiary czynników), `--threads n`.
+ *
+ * @return Kod zakończenia programu.
+ */
+int runMultiplyBenchmark(int argc, char* argv[]);
+
+/**
+ * @brief Nieujemna liczba stałoprzecinkowa: mantysa · limbBase^(−precyzja).
+ *
+ * Wszystkie wartości pośrednie algorytmu AGM są dodatnie, więc wystarcza
+ * reprezentacja bez znaku. Wyniki działań są obcinane do precyzji argumentów.
+ */
+class FixedPoint {
+public:
+    /// Zero o precyzji \p precision limbów ułamkowych.
+    explicit FixedPoint(int precision = 0);
+
+    /// Liczba całkowita \p value o zadanej precyzji.
+    static FixedPoint fromInteger(std::uint32_t value, int precision);
+
+    /// Przybliżenie liczby \p value (dokładne do ok. 16 cyfr).
+    static FixedPoint fromDouble(double value, int precision);
+
+    /// Liczba limbów części ułamkowej.
+    int precision() const { return fractionLimbs; }
+
+    /// Kopia o innej precyzji (obcięta lub uzupełniona zerami).
+    FixedPoint withPrecision(int precision) const;
+
+    /// Przybliżenie w typie double.
+    double toDouble() const;
+
+    /// Zapis dziesiętny z \p digits cyframi po przecinku (obcięty, nie zaokrąglony).
+    std::string toDecimal(int digits) const;
+
+    /// Czy wartość jest mniejsza od \p other.
+    bool operator<(const FixedPoint& other) const { return compareLimbs(mantissa, other.mantissa) < 0; }
+
+    friend FixedPoint operator+(const FixedPoint& a, const FixedPoint& b);
+    friend FixedPoint operator-(const FixedPoint& a, const FixedPoint& b);
+    friend FixedPoint multiply(const FixedPoint& a, const FixedPoint& b, ThreadPool* pool);
+    friend FixedPoint multiplySmall(const FixedPoint& a, std::uint32_t factor);
+    friend FixedPoint divideSmall(const FixedPoint& a, std::uint32_t divisor);
+
+    /// Moduł różnicy |a − b|.
+    friend FixedPoint absoluteDifference(const FixedPoint& a, const FixedPoint& b);
+
+    /// Czy wartość jest mniejsza niż limbBase^(−\p limbs).
+    bool isBelow(int limbs) const;
+
+private:
+    Limbs mantissa;
+    int fractionLimbs;
+};
+
+/**
+ * @brief Odwrotność pierwiastka 1/√a metodą Newtona z podwajaniem precyzji.
+ */
+FixedPoint inverseSqrt(const FixedPoint& a, ThreadPool* pool);
+
+/**
+ * @brief Pierwiastek √a (a · 1/√a z końcową poprawką Newtona).
+ */
+FixedPoint squareRoot(const FixedPoint& a, ThreadPool* pool);
+
+/**
+ * @brief Iloraz a / b (odwrotność b metodą Newtona pomnożona przez a).
+ */
+FixedPoint divide(const FixedPoint& a, const FixedPoint& b, ThreadPool* pool);
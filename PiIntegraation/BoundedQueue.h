@@ -0,0 +1,75 @@
+﻿/**
+ * @file BoundedQueue.h
+ * @brief Kolejka o ograniczonej pojemności łącząca etapy potoku przetwarzania.
+ *
+ * Producent blokuje się, gdy kolejka jest pełna, dzięki czemu szybszy etap
+ * nie zużywa dowolnie dużo pamięci. Po wywołaniu close() konsumenci odbierają
+ * pozostałe elementy, a następnie pop() zwraca false.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <utility>
+
+/**
+ * @brief Wielowątkowa kolejka FIFO o stałej pojemności.
+ * @tparam T Typ elementów (przenoszonych, nie kopiowanych).
+ */
+template <typename T>
+class BoundedQueue {
+public:
+    /// Tworzy kolejkę mieszczącą co najwyżej \p capacity elementów.
+    explicit BoundedQueue(std::size_t capacity) : capacity(capacity > 0 ? capacity : 1) {
+    }
+
+    /**
+     * @brief Wstawia element, czekając na wolne miejsce.
+     * @return false, jeśli kolejka została zamknięta.
+     */
+    bool push(T item) {
+        std::unique_lock<std::mutex> lock(queueMutex);
+        notFull.wait(lock, [&] { return closed || items.size() < capacity; });
+        if (closed) {
+            return false;
+        }
+        items.push_back(std::move(item));
+        notEmpty.notify_one();
+        return true;
+    }
+
+    /**
+     * @brief Pobiera element, czekając na jego pojawienie się.
+     * @return false, jeśli kolejka jest zamknięta i pusta.
+     */
+    bool pop(T& item) {
+        std::unique_lock<std::mutex> lock(queueMutex);
+        notEmpty.wait(lock, [&] { return closed || !items.empty(); });
+        if (items.empty()) {
+            return false;
+        }
+        item = std::move(items.front());
+        items.pop_front();
+        notFull.notify_one();
+        return true;
+    }
+
+    /// Zamyka kolejkę - kolejne push() się nie powiodą, a pop() opróżni resztę elementów.
+    void close() {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        closed = true;
+        notEmpty.notify_all();
+        notFull.notify_all();
+    }
+
+private:
+    std::size_t capacity;
+    bool closed = false;
+    std::deque<T> items;
+    std::mutex queueMutex;
+    std::condition_variable notEmpty;
+    std::condition_variable notFull;
+};
@@ -0,0 +1,42 @@
+﻿/**
+ * @file CommandLine.cpp
+ * @brief Implementacja funkcji pomocniczych do odczytu opcji wiersza poleceń.
+ */
+
+#include "CommandLine.h"
+
+#include <string>
+
+using namespace std;
+
+bool hasFlag(int argc, char* argv[], const string& name) {
+    for (int i = 1; i < argc; ++i) {
+        if (name == argv[i]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+string getOption(int argc, char* argv[], const string& name, const string& defaultValue) {
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (name == argv[i]) {
+            return argv[i + 1];
+        }
+    }
+    return defaultValue;
+}
+
+long long getIntOption(int argc, char* argv[], const string& name, long long defaultValue) {
+    string value = getOption(argc, argv, name, "");
+    if (value.empty()) {
+        return defaultValue;
+    }
+    // stod pozwala podać np. 3e9 zamiast 3000000000
+    return static_cast<long long>(stod(value));
+}
+
+double getDoubleOption(int argc, char* argv[], const string& name, double defaultValue) {
+    string value = getOption(argc, argv, name, "");
+    return value.empty() ? defaultValue : stod(value);
+}
@@ -0,0 +1,45 @@
+﻿/**
+ * @file CommandLine.h
+ * @brief Proste funkcje pomocnicze do odczytu opcji wiersza poleceń.
+ *
+ * Program uruchamiany bez argumentów wykonuje klasyczny przegląd wydajności.
+ * Pozostałe tryby wybierane są pierwszym argumentem (np. `stream`), a ich
+ * parametry podawane są w postaci `--nazwa wartość` lub jako flagi `--nazwa`.
+ */
+
+#pragma once
+
+#include <string>
+
+/**
+ * @brief Sprawdza, czy w wierszu poleceń podano flagę \p name.
+ *
+ * @param argc Liczba argumentów programu.
+ * @param argv Tablica argumentów programu.
+ * @param name Nazwa flagi razem z prefiksem, np. `--binary`.
+ * @return true, jeśli flaga występuje w argumentach.
+ */
+bool hasFlag(int argc, char* argv[], const std::string& name);
+
+/**
+ * @brief Zwraca wartość opcji \p name lub \p defaultValue, jeśli jej nie podano.
+ *
+ * @param argc Liczba argumentów programu.
+ * @param argv Tablica argumentów programu.
+ * @param name Nazwa opcji razem z prefiksem, np. `--dt`.
+ * @param defaultValue Wartość domyślna.
+ * @return Tekst występujący bezpośrednio po nazwie opcji.
+ */
+std::string getOption(int argc, char* argv[], const std::string& name, const std::string& defaultValue);
+
+/**
+ * @brief Wariant getOption() zwracający liczbę całkowitą.
+ *
+ * Akceptowany jest także zapis wykładniczy (np. `1e9`), wygodny przy liczbie kroków.
+ */
+long long getIntOption(int argc, char* argv[], const std::string& name, long long defaultValue);
+
+/**
+ * @brief Wariant getOption() zwracający liczbę zmiennoprzecinkową.
+ */
+double getDoubleOption(int argc, char* argv[], const std::string& name, double defaultValue);
@@ -0,0 +1,216 @@
+﻿/**
+ * @file CompressedPipeline.cpp
+ * @brief Implementacja potoku odczyt → dekompresja → całkowanie dla plików LZ4.
+ */
+
+#include "CompressedPipeline.h"
+#include "BoundedQueue.h"
+#include "CommandLine.h"
+#include "Lz4Decoder.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#endif
+
+using namespace std;
+
+namespace {
+
+/**
+ * @brief Zdekompresowany blok próbek.
+ */
+struct DecodedBlock {
+    long long index = 0;
+    vector<double> samples;
+};
+
+/**
+ * @brief Wynik częściowy jednego wątku całkującego.
+ *
+ * Suma próbek nie zależy od kolejności bloków, więc wątki nie muszą się
+ * synchronizować. Do poprawki trapezów potrzebne są tylko pierwsza próbka
+ * pierwszego bloku i ostatnia próbka ostatniego bloku.
+ */
+struct IntegratorState {
+    double sum = 0.0;
+    double compensation = 0.0;
+    long long samples = 0;
+    bool hasFirst = false;
+    double firstSample = 0.0;
+    long long lastIndex = -1;
+    double lastSample = 0.0;
+};
+
+void integrateBlocks(BoundedQueue<DecodedBlock>& decoded, IntegratorState& state) {
+    DecodedBlock block;
+    while (decoded.pop(block)) {
+        if (block.samples.empty()) {
+            continue;
+        }
+        for (double sample : block.samples) {
+            double value = sample - state.compensation;
+            double updated = state.sum + value;
+            state.compensation = (updated - state.sum) - value;
+            state.sum = updated;
+        }
+        state.samples += static_cast<long long>(block.samples.size());
+        if (block.index == 0) {
+            state.hasFirst = true;
+            state.firstSample = block.samples.front();
+        }
+        if (block.index > state.lastIndex) {
+            state.lastIndex = block.index;
+            state.lastSample = block.samples.back();
+        }
+    }
+}
+
+} // namespace
+
+CompressedIntegrationResult integrateCompressed(const char* inputPath, double dt, int decoders, int integrators, int queueCapacity) {
+    CompressedIntegrationResult result;
+
+    FILE* input = stdin;
+    if (inputPath[0] != '\0') {
+        input = fopen(inputPath, "rb");
+        if (input == nullptr) {
+            cerr << "Nie można otworzyć pliku " << inputPath << " do odczytu." << endl;
+            return result;
+        }
+    }
+#ifdef _WIN32
+    else {
+        _setmode(_fileno(stdin), _O_BINARY);
+    }
+#endif
+
+    BoundedQueue<Lz4Block> compressed(queueCapacity);
+    BoundedQueue<DecodedBlock> decoded(queueCapacity);
+    atomic<int> activeDecoders(decoders);
+    atomic<bool> corrupted(false);
+    atomic<long long> decodedBytes(0);
+
+    // Etap 2: dekompresja bloków przez grupę wątków
+    vector<thread> decoderThreads;
+    for (int i = 0; i < decoders; ++i) {
+        decoderThreads.emplace_back([&] {
+            Lz4Block block;
+            while (compressed.pop(block)) {
+                DecodedBlock out;
+                out.index = block.index;
+                out.samples.resize(block.maxSize / sizeof(double));
+                char* destination = reinterpret_cast<char*>(out.samples.data());
+                long long size = static_cast<long long>(block.data.size());
+                if (block.compressed) {
+                    size = decompressLz4Block(block.data.data(), block.data.size(), destination, block.maxSize);
+                }
+                else {
+                    memcpy(destination, block.data.data(), block.data.size());
+                }
+                if (size < 0 || size % sizeof(double) != 0) {
+                    corrupted = true; // Uszkodzony blok lub próbka przecięta granicą bloku
+                    continue;
+                }
+                out.samples.resize(static_cast<size_t>(size) / sizeof(double));
+                decodedBytes += size;
+                decoded.push(std::move(out));
+            }
+            if (--activeDecoders == 0) {
+                decoded.close();
+            }
+        });
+    }
+
+    // Etap 3: całkowanie zdekompresowanych bloków
+    vector<IntegratorState> states(integrators);
+    vector<thread> integratorThreads;
+    for (int i = 0; i < integrators; ++i) {
+        integratorThreads.emplace_back(integrateBlocks, ref(decoded), ref(states[i]));
+    }
+
+    // Etap 1: odczyt bloków w bieżącym wątku
+    Lz4FrameReader reader(input);
+    Lz4Block block;
+    while (reader.next(block)) {
+        result.compressedBytes += static_cast<long long>(block.data.size());
+        compressed.push(std::move(block));
+        block = Lz4Block();
+    }
+    compressed.close();
+
+    for (auto& t : decoderThreads) {
+        t.join();
+    }
+    for (auto& t : integratorThreads) {
+        t.join();
+    }
+    if (input != stdin) {
+        fclose(input);
+    }
+
+    if (!reader.error().empty()) {
+        cerr << reader.error() << endl;
+        return result;
+    }
+    if (corrupted) {
+        cerr << "Uszkodzone dane LZ4 lub rozmiar bloku niepodzielny przez rozmiar próbki." << endl;
+        return result;
+    }
+
+    // Redukcja wyników wątków i poprawka trapezów na końcach przedziału
+    double sum = 0.0;
+    double firstSample = 0.0;
+    double lastSample = 0.0;
+    long long lastIndex = -1;
+    for (const IntegratorState& state : states) {
+        sum += state.sum;
+        result.samples += state.samples;
+        if (state.hasFirst) {
+            firstSample = state.firstSample;
+        }
+        if (state.lastIndex > lastIndex) {
+            lastIndex = state.lastIndex;
+            lastSample = state.lastSample;
+        }
+    }
+    if (result.samples > 1) {
+        result.integral = (sum - 0.5 * (firstSample + lastSample)) * dt;
+    }
+    result.decodedBytes = decodedBytes;
+    result.ok = true;
+    return result;
+}
+
+int runCompressedMode(int argc, char* argv[]) {
+    string inputPath = getOption(argc, argv, "--input", "");
+    double dt = getDoubleOption(argc, argv, "--dt", 1.0);
+    int hardwareThreads = max(1, static_cast<int>(thread::hardware_concurrency()));
+    int decoders = static_cast<int>(max(1LL, getIntOption(argc, argv, "--decoders", max(1, hardwareThreads / 2))));
+    int integrators = static_cast<int>(max(1LL, getIntOption(argc, argv, "--integrators", max(1, hardwareThreads / 2))));
+    int queueCapacity = static_cast<int>(max(1LL, getIntOption(argc, argv, "--queue", 2 * decoders)));
+
+    auto startTime = chrono::high_resolution_clock::now();
+    CompressedIntegrationResult result = integrateCompressed(inputPath.c_str(), dt, decoders, integrators, queueCapacity);
+    auto endTime = chrono::high_resolution_clock::now();
+    chrono::duration<double> duration = endTime - startTime;
+    if (!result.ok) {
+        return 1;
+    }
+
+    cout << "Próbki: " << result.samples << ", Całka: " << result.integral
+        << ", Czas: " << duration.count() << "s" << endl;
+    cout << "Dane skompresowane: " << result.compressedBytes << " B, po dekompresji: " << result.decodedBytes
+        << " B, przepustowość: " << result.decodedBytes / duration.count() / 1e6 << " MB/s" << endl;
+    return 0;
+}
@@ -0,0 +1,44 @@
+﻿/**
+ * @file CompressedPipeline.h
+ * @brief Potok: odczyt skompresowanych próbek, równoległa dekompresja i całkowanie.
+ *
+ * Zarchiwizowane próbki (surowe wartości double) przechowywane są w plikach LZ4.
+ * Zamiast dekompresji na dysk, bloki są dekompresowane przez grupę wątków
+ * i od razu przekazywane do wątków całkujących. Etapy połączone są kolejkami
+ * o ograniczonej pojemności, więc dekompresja i obliczenia odbywają się
+ * jednocześnie przy stałym zużyciu pamięci.
+ */
+
+#pragma once
+
+/**
+ * @brief Wynik całkowania danych skompresowanych.
+ */
+struct CompressedIntegrationResult {
+    bool ok = false;               ///< Czy dane zostały poprawnie odczytane.
+    double integral = 0.0;         ///< Całka metodą trapezów.
+    long long samples = 0;         ///< Liczba próbek.
+    long long compressedBytes = 0; ///< Liczba bajtów danych skompresowanych.
+    long long decodedBytes = 0;    ///< Liczba bajtów po dekompresji.
+};
+
+/**
+ * @brief Całkuje próbki z pliku LZ4 metodą trapezów.
+ *
+ * @param inputPath Ścieżka pliku .lz4 (pusty tekst oznacza stdin).
+ * @param dt Odstęp między próbkami.
+ * @param decoders Liczba wątków dekompresujących.
+ * @param integrators Liczba wątków całkujących.
+ * @param queueCapacity Pojemność każdej z kolejek między etapami (w blokach).
+ * @return Wynik całkowania; przy błędzie \p ok ma wartość false.
+ */
+CompressedIntegrationResult integrateCompressed(const char* inputPath, double dt, int decoders, int integrators, int queueCapacity);
+
+/**
+ * @brief Uruchamia tryb `compressed`.
+ *
+ * Opcje: `--input plik.lz4`, `--dt x`, `--decoders n`, `--integrators n`, `--queue n`.
+ *
+ * @return Kod zakończenia programu.
+ */
+int runCompressedMode(int argc, char* argv[]);
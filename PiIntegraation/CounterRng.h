@@ -0,0 +1,69 @@
+﻿/**
+ * @file CounterRng.h
+ * @brief Generator liczb losowych oparty na liczniku (Philox4x32-10).
+ *
+ * Liczba losowa jest czystą funkcją pary (klucz, licznik), więc każda próbka
+ * Monte Carlo może wyznaczyć własne liczby bez wspólnego stanu generatora.
+ * Wynik nie zależy od liczby wątków ani od kolejności wykonania fragmentów.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+/**
+ * @brief Strumień liczb losowych dla jednej próbki.
+ *
+ * Licznik składa się z numeru strumienia (np. iteracji algorytmu), numeru
+ * próbki i numeru bloku kolejnych czterech słów w obrębie próbki.
+ */
+class CounterRng {
+public:
+    /**
+     * @param seed Ziarno (klucz szyfru Philox).
+     * @param stream Numer strumienia, np. iteracji.
+     * @param sample Numer próbki w strumieniu.
+     */
+    CounterRng(std::uint64_t seed, std::uint32_t stream, std::uint64_t sample)
+        : key{ static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32) },
+          counter{ 0, static_cast<std::uint32_t>(sample), static_cast<std::uint32_t>(sample >> 32), stream } {}
+
+    /// Liczba z przedziału [0, 1) z 53 bitami losowości.
+    double uniform() {
+        if (used == 4) {
+            block = philox(counter, key);
+            ++counter[0];
+            used = 0;
+        }
+        std::uint64_t high = block[used] >> 5;
+        std::uint64_t low = block[used + 1] >> 6;
+        used += 2;
+        return static_cast<double>((high << 26) | low) * (1.0 / 9007199254740992.0);
+    }
+
+    /// Dziesięć rund Philox4x32 dla licznika \p input i klucza \p seedKey.
+    static std::array<std::uint32_t, 4> philox(std::array<std::uint32_t, 4> input, std::array<std::uint32_t, 2> seedKey) {
+        const std::uint32_t multiplier0 = 0xD2511F53u, multiplier1 = 0xCD9E8D57u;
+        const std::uint32_t weyl0 = 0x9E3779B9u, weyl1 = 0xBB67AE85u;
+        for (int round = 0; round < 10; ++round) {
+            std::uint64_t product0 = static_cast<std::uint64_t>(multiplier0) * input[0];
+            std::uint64_t product1 = static_cast<std::uint64_t>(multiplier1) * input[2];
+            input = {
+                static_cast<std::uint32_t>(product1 >> 32) ^ input[1] ^ seedKey[0],
+                static_cast<std::uint32_t>(product1),
+                static_cast<std::uint32_t>(product0 >> 32) ^ input[3] ^ seedKey[1],
+                static_cast<std::uint32_t>(product0),
+            };
+            seedKey[0] += weyl0;
+            seedKey[1] += weyl1;
+        }
+        return input;
+    }
+
+private:
+    std::array<std::uint32_t, 2> key;
+    std::array<std::uint32_t, 4> counter;
+    std::array<std::uint32_t, 4> block{};
+    int used = 4;
+};
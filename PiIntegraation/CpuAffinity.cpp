@@ -0,0 +1,44 @@
+﻿/**
+ * @file CpuAffinity.cpp
+ * @brief Implementacja przypinania wątków dla Windows i Linuksa.
+ */
+
+#include "CpuAffinity.h"
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+using namespace std;
+
+bool pinCurrentThread(const vector<int>& cores) {
+    if (cores.empty()) {
+        return false;
+    }
+#ifdef _WIN32
+    DWORD_PTR mask = 0;
+    for (int core : cores) {
+        if (core < 0 || core >= static_cast<int>(sizeof(DWORD_PTR) * 8)) {
+            return false;
+        }
+        mask |= static_cast<DWORD_PTR>(1) << core;
+    }
+    return SetThreadAffinityMask(GetCurrentThread(), mask) != 0;
+#elif defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int core : cores) {
+        if (core < 0 || core >= CPU_SETSIZE) {
+            return false;
+        }
+        CPU_SET(core, &set);
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    return false;
+#endif
+}
@@ -0,0 +1,18 @@
+﻿/**
+ * @file CpuAffinity.h
+ * @brief Przypinanie wątków do wybranych rdzeni procesora.
+ */
+
+#pragma once
+
+#include <vector>
+
+/**
+ * @brief Ogranicza bieżący wątek do rdzeni \p cores (numeracja od 0).
+ *
+ * Windows: SetThreadAffinityMask (pierwsza grupa procesorów, do 64 rdzeni),
+ * Linux: pthread_setaffinity_np. Na pozostałych systemach nic nie robi.
+ *
+ * @return true, jeśli system przyjął maskę.
+ */
+bool pinCurrentThread(const std::vector<int>& cores);
@@ -0,0 +1,168 @@
+﻿/**
+ * @file CumulativeIntegral.cpp
+ * @brief Implementacja całki narastającej jako równoległego skanu z sumami prefiksowymi w rejestrach SIMD.
+ */
+
+#include "CumulativeIntegral.h"
+#include "CommandLine.h"
+#include "Integration.h"
+#include "MappedFile.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define PI_SCAN_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PI_SCAN_SSE2 1
+#endif
+
+using namespace std;
+
+namespace {
+
+/// Liczba prostokątów obliczanych jednorazowo przed skanem bloku (mieści się w L1).
+constexpr int blockSize = 256;
+
+/**
+ * @brief Inkluzywna suma prefiksowa bloku \p values dodana do przeniesienia \p carry.
+ *
+ * Sumy prefiksowe wewnątrz wektora liczone są przesunięciami w rejestrze
+ * (log2 szerokości wektora dodawań), a przeniesienie jest rozgłaszane do
+ * wszystkich linii. Wynik trafia bezpośrednio do \p out.
+ */
+void scanBlock(const double* values, int count, double* out, double& carry) {
+    int i = 0;
+#if defined(PI_SCAN_AVX)
+    __m256d running = _mm256_set1_pd(carry);
+    for (; i + 4 <= count; i += 4) {
+        __m256d x = _mm256_loadu_pd(values + i);                                   // [a, b, c, d]
+        __m256d shifted = _mm256_permute_pd(x, 0x5);                               // [b, a, d, c]
+        x = _mm256_add_pd(x, _mm256_blend_pd(_mm256_setzero_pd(), shifted, 0xA));  // [a, a+b, c, c+d]
+        __m256d low = _mm256_permute2f128_pd(x, x, 0x08);                          // [0, 0, a, a+b]
+        x = _mm256_add_pd(x, _mm256_permute_pd(low, 0xF));                         // [a, a+b, a+b+c, a+b+c+d]
+        x = _mm256_add_pd(x, running);
+        _mm256_storeu_pd(out + i, x);
+        running = _mm256_permute_pd(_mm256_permute2f128_pd(x, x, 0x11), 0xF);     // Rozgłoszenie ostatniej linii
+    }
+    carry = _mm256_cvtsd_f64(running);
+#elif defined(PI_SCAN_SSE2)
+    __m128d running = _mm_set1_pd(carry);
+    for (; i + 2 <= count; i += 2) {
+        __m128d x = _mm_loadu_pd(values + i);                        // [a, b]
+        x = _mm_add_pd(x, _mm_unpacklo_pd(_mm_setzero_pd(), x));      // [a, a+b]
+        x = _mm_add_pd(x, running);
+        _mm_storeu_pd(out + i, x);
+        running = _mm_unpackhi_pd(x, x);                              // Rozgłoszenie ostatniej linii
+    }
+    carry = _mm_cvtsd_f64(running);
+#endif
+    for (; i < count; ++i) {
+        carry += values[i];
+        out[i] = carry;
+    }
+}
+
+/**
+ * @brief Drugi przebieg skanu dla jednego fragmentu siatki.
+ *
+ * @param first Indeks pierwszego prostokąta fragmentu.
+ * @param count Liczba prostokątów fragmentu.
+ * @param stepSize Szerokość prostokąta.
+ * @param offset Wartość całki na początku fragmentu (z przebiegu 1).
+ * @param out Miejsce zapisu F w prawych końcach prostokątów fragmentu.
+ */
+void scanChunk(long long first, long long count, double stepSize, double offset, double* out) {
+    double values[blockSize];
+    double start = first * stepSize;
+    double carry = offset;
+    for (long long done = 0; done < count; done += blockSize) {
+        int n = static_cast<int>(min<long long>(blockSize, count - done));
+        for (int j = 0; j < n; ++j) {
+            double x = start + (done + j) * stepSize + stepSize / 2.0; // Środek prostokąta, jak w calculatePartialIntegral()
+            values[j] = f(x) * stepSize;
+        }
+        scanBlock(values, n, out + done, carry);
+    }
+}
+
+} // namespace
+
+void calculateCumulativeIntegral(long long steps, int numThreads, double* output) {
+    double stepSize = 1.0 / static_cast<double>(steps);
+    numThreads = static_cast<int>(max(1LL, min<long long>(numThreads, steps)));
+
+    // Podział na fragmenty - reszta z dzielenia trafia do ostatnich fragmentów
+    vector<long long> chunkBegin(numThreads + 1);
+    for (int i = 0; i <= numThreads; ++i) {
+        chunkBegin[i] = steps * i / numThreads;
+    }
+
+    // Przebieg 1: suma każdego fragmentu
+    vector<double> chunkSums(numThreads, 0.0);
+    {
+        vector<thread> threads;
+        for (int i = 0; i < numThreads; ++i) {
+            long long count = chunkBegin[i + 1] - chunkBegin[i];
+            double start = chunkBegin[i] * stepSize;
+            double end = chunkBegin[i + 1] * stepSize;
+            threads.emplace_back(calculatePartialIntegral, start, end, count, stepSize, ref(chunkSums[i]));
+        }
+        for (auto& t : threads) {
+            t.join();
+        }
+    }
+
+    // Skan wyłączny sum fragmentów - wartość całki na początku każdego fragmentu
+    vector<double> offsets(numThreads, 0.0);
+    for (int i = 1; i < numThreads; ++i) {
+        offsets[i] = offsets[i - 1] + chunkSums[i - 1];
+    }
+
+    // Przebieg 2: lokalne sumy prefiksowe z przesunięciem fragmentu
+    output[0] = 0.0;
+    vector<thread> threads;
+    for (int i = 0; i < numThreads; ++i) {
+        long long first = chunkBegin[i];
+        threads.emplace_back(scanChunk, first, chunkBegin[i + 1] - first, stepSize, offsets[i], output + first + 1);
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+}
+
+int runCumulativeMode(int argc, char* argv[]) {
+    long long steps = max(1LL, getIntOption(argc, argv, "--steps", 10000000));
+    int numThreads = static_cast<int>(getIntOption(argc, argv, "--threads", thread::hardware_concurrency()));
+    string outputPath = getOption(argc, argv, "--output", "cumulative.bin");
+
+    MappedFile outputFile(outputPath, static_cast<size_t>(steps + 1) * sizeof(double));
+    if (!outputFile.is_open()) {
+        cerr << "Nie można utworzyć pliku " << outputPath << " odwzorowanego w pamięci." << endl;
+        return 1;
+    }
+    double* output = static_cast<double*>(outputFile.get());
+
+    auto startTime = chrono::high_resolution_clock::now();
+    calculateCumulativeIntegral(steps, numThreads, output);
+    auto endTime = chrono::high_resolution_clock::now();
+    chrono::duration<double> duration = endTime - startTime;
+
+    // Kontrola: F(x) = 4 * atan(x)
+    long long middle = steps / 2;
+    double x = static_cast<double>(middle) / static_cast<double>(steps);
+    cout << "Liczba kroków: " << steps << ", Wątki: " << numThreads << ", Czas: " << duration.count() << "s" << endl;
+    cout << setprecision(12);
+    cout << "F(" << x << ") = " << output[middle] << " (dokładnie " << 4.0 * atan(x) << ")" << endl;
+    cout << "F(1) = " << output[steps] << " (PI)" << endl;
+    cout << "Wyniki zapisane do pliku " << outputPath << endl;
+    return 0;
+}
@@ -0,0 +1,35 @@
+﻿/**
+ * @file CumulativeIntegral.h
+ * @brief Równoległe obliczanie całki narastającej \( F(x) = \int_0^x f(t)\,dt \) w każdym punkcie siatki.
+ *
+ * W przeciwieństwie do calculatePartialIntegral(), która zwraca tylko sumę,
+ * ten tryb zapisuje wartość całki w każdym z \p steps + 1 punktów siatki.
+ * Obliczenia wykonywane są jako dwuprzebiegowy równoległy skan (sumy prefiksowe).
+ */
+
+#pragma once
+
+/**
+ * @brief Oblicza całkę narastającą funkcji f() na przedziale [0, 1].
+ *
+ * ### Wyjaśnienie działania:
+ * - Przebieg 1: każdy wątek liczy sumę pól prostokątów swojego fragmentu.
+ * - Skan wyłączny sum fragmentów daje wartość całki na początku każdego fragmentu.
+ * - Przebieg 2: każdy wątek ponownie przechodzi swój fragment, licząc sumy prefiksowe
+ *   w rejestrach SIMD i dodając przesunięcie fragmentu.
+ *
+ * @param steps Liczba prostokątów (tablica wynikowa ma \p steps + 1 elementów).
+ * @param numThreads Liczba wątków.
+ * @param output Tablica wynikowa; output[i] = F(i / steps).
+ */
+void calculateCumulativeIntegral(long long steps, int numThreads, double* output);
+
+/**
+ * @brief Uruchamia tryb `cumulative`.
+ *
+ * Opcje: `--steps n`, `--threads n`, `--output plik` (domyślnie cumulative.bin).
+ * Wynik jest zapisywany jako surowa tablica double w pliku odwzorowanym w pamięci.
+ *
+ * @return Kod zakończenia programu.
+ */
+int runCumulativeMode(int argc, char* argv[]);
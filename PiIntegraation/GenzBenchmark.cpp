@@ -0,0 +1,316 @@
+﻿/**
+ * @file GenzBenchmark.cpp
+ * @brief Implementacja funkcji testowych Genza i przeglądu metod całkowania.
+ */
+
+#include "GenzBenchmark.h"
+#include "CommandLine.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+constexpr double pi = 3.14159265358979323846;
+
+const GenzFamily allFamilies[] = {
+    GenzFamily::Oscillatory, GenzFamily::ProductPeak, GenzFamily::CornerPeak,
+    GenzFamily::Gaussian, GenzFamily::Continuous, GenzFamily::Discontinuous,
+};
+
+/**
+ * @brief Trudność rodziny: \( \sum a_i = b / d^{e} \) (stałe b i e z pakietu Genza).
+ */
+double genzDifficulty(GenzFamily family, int dimensions) {
+    static const double budget[] = { 110.0, 600.0, 600.0, 100.0, 150.0, 100.0 };
+    static const double exponent[] = { 1.5, 2.0, 2.0, 1.0, 2.0, 2.0 };
+    int index = static_cast<int>(family);
+    return budget[index] / pow(static_cast<double>(dimensions), exponent[index]);
+}
+
+/**
+ * @brief Całka dokładna piku w narożniku (włączanie-wyłączanie po wierzchołkach hipersześcianu).
+ *
+ * \( \int (1 + a \cdot x)^{-(d+1)} = \frac{1}{d! \prod a_i} \sum_{S} \frac{(-1)^{|S|}}{1 + \sum_{i \in S} a_i} \).
+ */
+double cornerPeakExact(const vector<double>& a) {
+    int d = static_cast<int>(a.size());
+    double sum = 0.0;
+    for (unsigned mask = 0; mask < (1u << d); ++mask) {
+        double denominator = 1.0;
+        int bits = 0;
+        for (int i = 0; i < d; ++i) {
+            if (mask & (1u << i)) {
+                denominator += a[i];
+                ++bits;
+            }
+        }
+        sum += (bits % 2 == 0 ? 1.0 : -1.0) / denominator;
+    }
+    double scale = 1.0;
+    for (int i = 0; i < d; ++i) {
+        scale *= (i + 1) * a[i];
+    }
+    return sum / scale;
+}
+
+/**
+ * @brief Kwadratura punktów środkowych na siatce \p perDimension^d - wielowymiarowa metoda prostokątów.
+ *
+ * Punkty siatki numerowane są liniowo i dzielone między wątki puli jak
+ * kroki w przeglądzie wydajności.
+ */
+MonteCarloResult midpointGrid(const Integrand& integrand, long long perDimension, ThreadPool& pool) {
+    int d = integrand.dimensions;
+    long long points = 1;
+    for (int i = 0; i < d; ++i) {
+        points *= perDimension;
+    }
+    int chunks = static_cast<int>(min<long long>(points, pool.size() * 8));
+    vector<double> partial(chunks, 0.0);
+    double step = 1.0 / static_cast<double>(perDimension);
+    pool.parallelFor(points, chunks, [&](long long begin, long long end, int chunk) {
+        vector<double> x(d);
+        double sum = 0.0;
+        for (long long index = begin; index < end; ++index) {
+            long long rest = index;
+            for (int i = 0; i < d; ++i) {
+                x[i] = (rest % perDimension + 0.5) * step;
+                rest /= perDimension;
+            }
+            sum += integrand.function(x.data());
+        }
+        partial[chunk] = sum;
+    });
+
+    MonteCarloResult result;
+    for (double value : partial) {
+        result.estimate += value;
+    }
+    result.estimate /= static_cast<double>(points);
+    result.evaluations = points;
+    return result;
+}
+
+vector<int> parseIntegerList(const string& text) {
+    vector<int> values;
+    stringstream stream(text);
+    for (string item; getline(stream, item, ',');) {
+        values.push_back(static_cast<int>(stod(item)));
+    }
+    return values;
+}
+
+} // namespace
+
+string genzFamilyName(GenzFamily family) {
+    static const char* names[] = { "oscillatory", "product-peak", "corner-peak", "gaussian", "continuous", "discontinuous" };
+    return names[static_cast<int>(family)];
+}
+
+Integrand genzIntegrand(GenzFamily family, int dimensions, uint64_t seed) {
+    int d = max(1, dimensions);
+    mt19937_64 generator(seed);
+    uniform_real_distribution<double> uniform(0.0, 1.0);
+    vector<double> a(d), u(d);
+    double sum = 0.0;
+    for (int i = 0; i < d; ++i) {
+        a[i] = uniform(generator) + 0.1; // Dolne ograniczenie - żaden wymiar nie jest pominięty
+        u[i] = uniform(generator);
+        sum += a[i];
+    }
+    double difficulty = genzDifficulty(family, d);
+    for (double& value : a) {
+        value *= difficulty / sum;
+    }
+
+    Integrand integrand;
+    integrand.name = genzFamilyName(family);
+    integrand.dimensions = d;
+    switch (family) {
+    case GenzFamily::Oscillatory: {
+        integrand.function = [a, u, d](const double* x) {
+            double phase = 2.0 * pi * u[0];
+            for (int i = 0; i < d; ++i) {
+                phase += a[i] * x[i];
+            }
+            return cos(phase);
+        };
+        complex<double> exact = polar(1.0, 2.0 * pi * u[0]);
+        for (int i = 0; i < d; ++i) {
+            exact *= (polar(1.0, a[i]) - 1.0) / complex<double>(0.0, a[i]);
+        }
+        integrand.exact = exact.real();
+        break;
+    }
+    case GenzFamily::ProductPeak:
+        integrand.function = [a, u, d](const double* x) {
+            double product = 1.0;
+            for (int i = 0; i < d; ++i) {
+                double t = x[i] - u[i];
+                product /= 1.0 / (a[i] * a[i]) + t * t;
+            }
+            return product;
+        };
+        integrand.exact = 1.0;
+        for (int i = 0; i < d; ++i) {
+            integrand.exact *= a[i] * (atan(a[i] * (1.0 - u[i])) + atan(a[i] * u[i]));
+        }
+        break;
+    case GenzFamily::CornerPeak:
+        integrand.function = [a, d](const double* x) {
+            double sum = 1.0;
+            for (int i = 0; i < d; ++i) {
+                sum += a[i] * x[i];
+            }
+            return pow(sum, -(d + 1.0));
+        };
+        integrand.exact = cornerPeakExact(a);
+        break;
+    case GenzFamily::Gaussian:
+        integrand.function = [a, u, d](const double* x) {
+            double exponent = 0.0;
+            for (int i = 0; i < d; ++i) {
+                double t = a[i] * (x[i] - u[i]);
+                exponent += t * t;
+            }
+            return exp(-exponent);
+        };
+        integrand.exact = 1.0;
+        for (int i = 0; i < d; ++i) {
+            integrand.exact *= sqrt(pi) / (2.0 * a[i]) * (erf(a[i] * (1.0 - u[i])) + erf(a[i] * u[i]));
+        }
+        break;
+    case GenzFamily::Continuous:
+        integrand.function = [a, u, d](const double* x) {
+            double exponent = 0.0;
+            for (int i = 0; i < d; ++i) {
+                exponent += a[i] * fabs(x[i] - u[i]);
+            }
+            return exp(-exponent);
+        };
+        integrand.exact = 1.0;
+        for (int i = 0; i < d; ++i) {
+            integrand.exact *= (2.0 - exp(-a[i] * u[i]) - exp(-a[i] * (1.0 - u[i]))) / a[i];
+        }
+        break;
+    case GenzFamily::Discontinuous:
+        integrand.function = [a, u, d](const double* x) {
+            if (x[0] > u[0] || (d > 1 && x[1] > u[1])) {
+                return 0.0;
+            }
+            double exponent = 0.0;
+            for (int i = 0; i < d; ++i) {
+                exponent += a[i] * x[i];
+            }
+            return exp(exponent);
+        };
+        integrand.exact = 1.0;
+        for (int i = 0; i < d; ++i) {
+            double bound = i < 2 ? u[i] : 1.0;
+            integrand.exact *= (exp(a[i] * bound) - 1.0) / a[i];
+        }
+        break;
+    }
+    return integrand;
+}
+
+int runGenzMode(int argc, char* argv[]) {
+    string familiesList = getOption(argc, argv, "--families", "all");
+    vector<int> dimensionsList = parseIntegerList(getOption(argc, argv, "--dims", "1,2,4,6,8,10"));
+    string evaluationsList = getOption(argc, argv, "--evaluations", "10000,100000,1000000");
+    uint64_t seed = static_cast<uint64_t>(getIntOption(argc, argv, "--seed", 1));
+    int numThreads = static_cast<int>(getIntOption(argc, argv, "--threads", thread::hardware_concurrency()));
+    string outputPath = getOption(argc, argv, "--output", "genz.csv");
+
+    vector<GenzFamily> families;
+    if (familiesList == "all") {
+        families.assign(begin(allFamilies), end(allFamilies));
+    }
+    else {
+        stringstream stream(familiesList);
+        for (string item; getline(stream, item, ',');) {
+            auto found = find_if(begin(allFamilies), end(allFamilies),
+                [&](GenzFamily family) { return genzFamilyName(family) == item; });
+            if (found == end(allFamilies)) {
+                cerr << "Nieznana rodzina funkcji: " << item << endl;
+                return 1;
+            }
+            families.push_back(*found);
+        }
+    }
+    vector<long long> budgets;
+    {
+        stringstream stream(evaluationsList);
+        for (string item; getline(stream, item, ',');) {
+            budgets.push_back(max(100LL, static_cast<long long>(stod(item))));
+        }
+    }
+
+    ofstream outputFile(outputPath);
+    if (!outputFile.is_open()) {
+        cerr << "Nie można otworzyć pliku " << outputPath << " do zapisu." << endl;
+        return 1;
+    }
+    outputFile << "Rodzina,Wymiar,Metoda,Budzet,Wywolania,Czas (s),Wynik,Wartosc dokladna,Blad wzgledny\n";
+
+    ThreadPool pool(static_cast<unsigned>(max(1, numThreads)));
+    for (GenzFamily family : families) {
+        for (int dimensions : dimensionsList) {
+            // Ta sama instancja funkcji dla wszystkich metod i budżetów
+            Integrand integrand = genzIntegrand(family, dimensions, seed + 1000 * static_cast<uint64_t>(dimensions));
+            for (long long budget : budgets) {
+                auto report = [&](const string& method, const MonteCarloResult& result, double seconds) {
+                    double error = fabs(result.estimate - integrand.exact) / max(fabs(integrand.exact), 1e-300);
+                    outputFile << integrand.name << "," << integrand.dimensions << "," << method << "," << budget << ","
+                        << result.evaluations << "," << seconds << "," << setprecision(15) << result.estimate << ","
+                        << integrand.exact << "," << setprecision(6) << error << "\n";
+                    cout << "Rodzina: " << integrand.name << ", Wymiar: " << integrand.dimensions
+                        << ", Metoda: " << method << ", Wywołania: " << result.evaluations
+                        << ", Czas: " << seconds << "s, Błąd względny: " << setprecision(3) << error
+                        << setprecision(6) << endl;
+                };
+                auto timed = [&](const string& method, auto&& compute) {
+                    auto startTime = chrono::high_resolution_clock::now();
+                    MonteCarloResult result = compute();
+                    chrono::duration<double> duration = chrono::high_resolution_clock::now() - startTime;
+                    report(method, result, duration.count());
+                };
+
+                // Siatka ma sens tylko, gdy w każdym wymiarze mieszczą się co najmniej dwa punkty
+                long long perDimension = static_cast<long long>(floor(pow(static_cast<double>(budget), 1.0 / dimensions) + 1e-9));
+                if (perDimension >= 2) {
+                    timed("siatka", [&] { return midpointGrid(integrand, perDimension, pool); });
+                }
+                timed("Monte Carlo", [&] { return plainMonteCarlo(integrand, budget, seed, pool); });
+                timed("VEGAS", [&] {
+                    VegasOptions options;
+                    options.iterations = 5;
+                    options.warmupIterations = 3;
+                    options.samplesPerIteration = budget / (options.iterations + options.warmupIterations);
+                    options.seed = seed;
+                    return vegasIntegrate(integrand, options, pool);
+                });
+                timed("MISER", [&] {
+                    MiserOptions options;
+                    options.samples = budget;
+                    options.seed = seed;
+                    return miserIntegrate(integrand, options, pool);
+                });
+            }
+        }
+    }
+    cout << "Wyniki zapisane do pliku " << outputPath << endl;
+    return 0;
+}
@@ -0,0 +1,51 @@
+﻿/**
+ * @file GenzBenchmark.h
+ * @brief Zestaw funkcji testowych Genza do porównywania dokładności i kosztu metod całkowania.
+ *
+ * Funkcja \( \frac{4}{1 + x^2} \) jest gładka i jednowymiarowa, więc każda metoda
+ * wypada na niej dobrze. Sześć rodzin Genza (oscylująca, pik iloczynowy, pik
+ * w narożniku, Gaussowska, ciągła, nieciągła) ma znane całki dokładne w dowolnym
+ * wymiarze i sprawdza metody na funkcjach o różnym charakterze.
+ */
+
+#pragma once
+
+#include "MonteCarlo.h"
+
+#include <cstdint>
+#include <string>
+
+/// Rodziny funkcji testowych Genza.
+enum class GenzFamily {
+    Oscillatory,   ///< \( \cos(2\pi u_1 + \sum a_i x_i) \)
+    ProductPeak,   ///< \( \prod (a_i^{-2} + (x_i - u_i)^2)^{-1} \)
+    CornerPeak,    ///< \( (1 + \sum a_i x_i)^{-(d+1)} \)
+    Gaussian,      ///< \( \exp(-\sum a_i^2 (x_i - u_i)^2) \)
+    Continuous,    ///< \( \exp(-\sum a_i |x_i - u_i|) \)
+    Discontinuous, ///< \( \exp(\sum a_i x_i) \) dla \( x_1 \le u_1, x_2 \le u_2 \), poza tym 0
+};
+
+/// Nazwa rodziny używana w opcji `--families` i w raporcie.
+std::string genzFamilyName(GenzFamily family);
+
+/**
+ * @brief Losowa instancja rodziny \p family w wymiarze \p dimensions z całką dokładną.
+ *
+ * Parametry \( u_i \) są losowane jednostajnie z [0, 1), a \( a_i \) losowane
+ * i skalowane tak, by \( \sum a_i \) było równe standardowej trudności rodziny
+ * (jak w pakiecie testowym Genza).
+ */
+Integrand genzIntegrand(GenzFamily family, int dimensions, std::uint64_t seed);
+
+/**
+ * @brief Uruchamia tryb `genz`.
+ *
+ * Opcje: `--families nazwa[,nazwa...]` (domyślnie wszystkie), `--dims d[,d...]`
+ * (domyślnie 1,2,4,6,8,10), `--evaluations n[,n...]` (budżety wywołań funkcji),
+ * `--seed n`, `--threads n`, `--output plik` (domyślnie genz.csv).
+ * Każda metoda (siatka punktów środkowych, zwykłe Monte Carlo, VEGAS, MISER)
+ * dostaje ten sam budżet; zapisywany jest błąd względny, liczba wywołań i czas.
+ *
+ * @return Kod zakończenia programu.
+ */
+int runGenzMode(int argc, char* argv[]);
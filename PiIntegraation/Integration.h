@@ -0,0 +1,22 @@
+﻿/**
+ * @file Integration.h
+ * @brief Deklaracje funkcji całkowania zdefiniowanych w PiIntegraation.cpp.
+ *
+ * Dzięki temu dodatkowe tryby programu korzystają z tej samej funkcji
+ * podcałkowej \( f(x) = \frac{4}{1 + x^2} \) i tej samej metody prostokątów,
+ * co główny przegląd wydajności.
+ */
+
+#pragma once
+
+class LiveResults;
+
+/// Funkcja podcałkowa \( f(x) = \frac{4}{1 + x^2} \), patrz PiIntegraation.cpp.
+double f(double x);
+
+/// Całka metodą prostokątów na podprzedziale, patrz PiIntegraation.cpp.
+void calculatePartialIntegral(double start, double end, long long steps, double stepSize, double& result);
+
+/// Liczba PI metodą prostokątów w \p numThreads nowych wątkach (jedna komórka przeglądu), patrz PiIntegraation.cpp.
+/// Jeśli podano \p live, wątki publikują w nim swój postęp.
+double calculatePi(long long steps, int numThreads, LiveResults* live = nullptr);
@@ -0,0 +1,127 @@
+﻿/**
+ * @file IntegrationEngine.cpp
+ * @brief Implementacja silnika bez alokacji i trybu `alloc`.
+ */
+
+#include "IntegrationEngine.h"
+#include "AllocationCounter.h"
+#include "CommandLine.h"
+#include "Integration.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+using namespace std;
+
+IntegrationEngine::IntegrationEngine(int maxThreads) : slots(static_cast<size_t>(max(1, maxThreads))) {
+    workers.reserve(slots.size() - 1);
+    for (int i = 1; i < static_cast<int>(slots.size()); ++i) {
+        workers.emplace_back(&IntegrationEngine::workerLoop, this, i);
+    }
+}
+
+IntegrationEngine::~IntegrationEngine() {
+    {
+        lock_guard<mutex> lock(engineMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& t : workers) {
+        t.join();
+    }
+}
+
+void IntegrationEngine::workerLoop(int slot) {
+    uint64_t seen = 0;
+    while (true) {
+        {
+            unique_lock<mutex> lock(engineMutex);
+            wake.wait(lock, [&] { return stopping || (generation != seen && slot < activeSlots); });
+            if (stopping) {
+                return;
+            }
+            seen = generation;
+        }
+        TaskSlot& task = slots[slot];
+        calculatePartialIntegral(task.start, task.start + task.steps * task.stepSize, task.steps, task.stepSize, task.result);
+        {
+            lock_guard<mutex> lock(engineMutex);
+            if (--pending == 0) {
+                done.notify_one();
+            }
+        }
+    }
+}
+
+double IntegrationEngine::calculatePi(long long steps, int numThreads) {
+    numThreads = clamp(numThreads, 1, maxThreads());
+    double stepSize = 1.0 / static_cast<double>(steps);
+    long long stepsPerThread = steps / numThreads;
+    for (int i = 0; i < numThreads; ++i) {
+        slots[i].start = i * stepsPerThread * stepSize;
+        slots[i].steps = stepsPerThread;
+        slots[i].stepSize = stepSize;
+    }
+    if (numThreads > 1) {
+        {
+            lock_guard<mutex> lock(engineMutex);
+            activeSlots = numThreads;
+            pending = numThreads - 1;
+            ++generation;
+        }
+        wake.notify_all();
+    }
+
+    // Wątek wywołujący liczy fragment 0 zamiast czekać bezczynnie
+    calculatePartialIntegral(slots[0].start, slots[0].start + stepsPerThread * stepSize, stepsPerThread, stepSize, slots[0].result);
+
+    if (numThreads > 1) {
+        unique_lock<mutex> lock(engineMutex);
+        done.wait(lock, [&] { return pending == 0; });
+    }
+    double pi = 0.0;
+    for (int i = 0; i < numThreads; ++i) {
+        pi += slots[i].result;
+    }
+    return pi;
+}
+
+int runAllocationMode(int argc, char* argv[]) {
+    long long steps = max(1LL, getIntOption(argc, argv, "--steps", 10000000));
+    int maxThreads = static_cast<int>(max(1LL, getIntOption(argc, argv, "--max-threads", 8)));
+    int repeats = static_cast<int>(max(1LL, getIntOption(argc, argv, "--repeats", 20)));
+
+    IntegrationEngine engine(maxThreads);
+    bool engineAllocated = false;
+
+    auto measure = [&](const char* name, int threads, auto&& integrate) {
+        integrate(); // Rozgrzewka (pierwsze użycie strumieni, wątków, leniwych inicjalizacji)
+        AllocationCounters before = processAllocations();
+        auto startTime = chrono::high_resolution_clock::now();
+        double pi = 0.0;
+        for (int r = 0; r < repeats; ++r) {
+            pi = integrate();
+        }
+        chrono::duration<double> duration = chrono::high_resolution_clock::now() - startTime;
+        AllocationCounters used = processAllocations() - before;
+        cout << "Metoda: " << name << ", Wątki: " << threads
+            << ", Alokacje/wywołanie: " << static_cast<double>(used.allocations) / repeats
+            << ", Bajty/wywołanie: " << static_cast<double>(used.bytes) / repeats
+            << ", Czas/wywołanie: " << duration.count() / repeats << "s, PI: " << pi << endl;
+        return used.allocations;
+    };
+
+    cout << "Liczba kroków: " << steps << ", Powtórzenia: " << repeats << endl;
+    for (int threads = 1; threads <= maxThreads; ++threads) {
+        measure("calculatePi", threads, [&] { return calculatePi(steps, threads); });
+        long long allocations = measure("IntegrationEngine", threads, [&] { return engine.calculatePi(steps, threads); });
+        engineAllocated = engineAllocated || allocations != 0;
+    }
+    if (engineAllocated) {
+        cerr << "Silnik alokował pamięć w stanie ustalonym." << endl;
+        return 1;
+    }
+    cout << "Silnik: brak alokacji w stanie ustalonym." << endl;
+    return 0;
+}
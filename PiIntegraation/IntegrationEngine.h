@@ -0,0 +1,80 @@
+﻿/**
+ * @file IntegrationEngine.h
+ * @brief Silnik metody prostokątów bez alokacji na ścieżce wywołania.
+ *
+ * calculatePi() przy każdym wywołaniu tworzy wątki oraz wektory wątków
+ * i wyników częściowych - to celowe w przeglądzie skalowania, ale w silniku
+ * wywoływanym wielokrotnie (serwer, pula) każde wywołanie alokowałoby
+ * pamięć. IntegrationEngine przydziela wszystko w konstruktorze: wątki robocze
+ * i tablicę stałych miejsc na zadania (po jednym na wątek, każde w osobnej
+ * linii pamięci podręcznej). Wywołanie wypełnia miejsca, budzi wątki i czeka
+ * na ich zakończenie, więc w stanie ustalonym nie wykonuje żadnej alokacji.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Stała pula wątków z miejscami na fragmenty całki \( \int_0^1 \frac{4}{1 + x^2} dx \).
+ *
+ * Wywołania calculatePi() nie mogą się nakładać (jeden wątek sterujący).
+ */
+class IntegrationEngine {
+public:
+    /// Przydziela \p maxThreads − 1 wątków roboczych (wątek wywołujący liczy fragment 0).
+    explicit IntegrationEngine(int maxThreads);
+    ~IntegrationEngine();
+
+    IntegrationEngine(const IntegrationEngine&) = delete;
+    IntegrationEngine& operator=(const IntegrationEngine&) = delete;
+
+    /**
+     * @brief Liczba PI z podziałem na \p numThreads fragmentów, jak w calculatePi().
+     *
+     * Podział i kolejność sumowania są takie same, więc wynik jest identyczny.
+     *
+     * @param numThreads Liczba fragmentów (ograniczona do maxThreads()).
+     */
+    double calculatePi(long long steps, int numThreads);
+
+    /// Największa liczba fragmentów jednego wywołania.
+    int maxThreads() const { return static_cast<int>(slots.size()); }
+
+private:
+    /// Miejsce na jeden fragment - parametry i wynik.
+    struct alignas(64) TaskSlot {
+        double start = 0.0;
+        long long steps = 0;
+        double stepSize = 0.0;
+        double result = 0.0;
+    };
+
+    void workerLoop(int slot);
+
+    std::vector<TaskSlot> slots;
+    std::vector<std::thread> workers;
+    std::mutex engineMutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    std::uint64_t generation = 0; ///< Numer bieżącego wywołania.
+    int activeSlots = 0;          ///< Liczba fragmentów bieżącego wywołania.
+    int pending = 0;              ///< Fragmenty wątków roboczych jeszcze niezakończone.
+    bool stopping = false;
+};
+
+/**
+ * @brief Uruchamia tryb `alloc` - alokacje i czas na jedno całkowanie.
+ *
+ * Porównuje calculatePi() (nowe wątki w każdym wywołaniu) z IntegrationEngine
+ * i wypisuje średnią liczbę alokacji, bajtów i czas na wywołanie, zmierzone
+ * po rozgrzewce. Opcje: `--steps n` (domyślnie 1e7), `--max-threads n`
+ * (domyślnie 8), `--repeats n` (domyślnie 20).
+ *
+ * @return Kod zakończenia programu (1, jeśli silnik alokował w stanie ustalonym).
+ */
+int runAllocationMode(int argc, char* argv[]);
@@ -0,0 +1,196 @@
+﻿/**
+ * @file IntegrationScheduler.cpp
+ * @brief Implementacja planisty fragmentów i trybu `priority`.
+ */
+
+#include "IntegrationScheduler.h"
+#include "CommandLine.h"
+#include "Integration.h"
+
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <thread>
+#include <tuple>
+
+using namespace std;
+
+/**
+ * @brief Stan jednego całkowania: fragmenty przydzielone, zakończone i ich wyniki.
+ */
+struct IntegrationScheduler::Job {
+    IntegrationRequest request;
+    chrono::steady_clock::time_point submitted;
+    unsigned long long sequence = 0;
+    double stepSize = 0.0;
+    long long chunks = 0;
+    long long nextChunk = 0;             ///< Chroniony przez jobsMutex.
+    atomic<long long> finishedChunks{ 0 };
+    vector<double> partials;
+    promise<IntegrationOutcome> result;
+};
+
+IntegrationScheduler::IntegrationScheduler(ThreadPool& pool, const SchedulerOptions& options)
+    : pool(pool), options(options) {
+    this->options.chunkSteps = max(1LL, options.chunkSteps);
+}
+
+IntegrationScheduler::~IntegrationScheduler() {
+    unique_lock<mutex> lock(jobsMutex);
+    dispatchersDone.wait(lock, [&] { return dispatchers == 0; });
+}
+
+future<IntegrationOutcome> IntegrationScheduler::submit(const IntegrationRequest& request) {
+    promise<IntegrationOutcome> result;
+    future<IntegrationOutcome> outcome = result.get_future();
+    submit(request, move(result));
+    return outcome;
+}
+
+void IntegrationScheduler::submit(const IntegrationRequest& request, promise<IntegrationOutcome> result) {
+    auto job = make_shared<Job>();
+    job->request = request;
+    job->result = move(result);
+    job->request.steps = max(1LL, request.steps);
+    job->submitted = chrono::steady_clock::now();
+    job->stepSize = (job->request.upper - job->request.lower) / static_cast<double>(job->request.steps);
+    job->chunks = (job->request.steps + options.chunkSteps - 1) / options.chunkSteps;
+    job->partials.assign(static_cast<size_t>(job->chunks), 0.0);
+    TaskPriority priority = options.usePriorities ? job->request.priority : TaskPriority::Normal;
+    long long count = 0;
+    {
+        lock_guard<mutex> lock(jobsMutex);
+        job->sequence = nextSequence++;
+        pending.push_back(job);
+        count = min<long long>(job->chunks, static_cast<long long>(pool.size()) - dispatchers);
+        count = max(0LL, count);
+        dispatchers += count;
+    }
+
+    // Zadania rozdzielające są wymienne - każde wykonuje najpilniejsze fragmenty wszystkich
+    // całkowań, aż ich zabraknie. Łącznie jest ich najwyżej pool.size(), więc planista
+    // nigdy nie zapełnia kolejki puli, a nowe całkowanie przejmują już działające zadania.
+    for (long long i = 0; i < count; ++i) {
+        pool.submit([this] {
+            while (runNextChunk()) {
+            }
+        }, priority);
+    }
+}
+
+bool IntegrationScheduler::runNextChunk() {
+    shared_ptr<Job> job;
+    long long chunk = 0;
+    {
+        lock_guard<mutex> lock(jobsMutex);
+        auto urgency = [&](const shared_ptr<Job>& candidate) {
+            int priority = options.usePriorities ? static_cast<int>(candidate->request.priority) : 0;
+            auto deadline = options.usePriorities ? candidate->request.deadline : chrono::steady_clock::time_point::max();
+            return make_tuple(priority, deadline, candidate->sequence);
+        };
+        auto best = min_element(pending.begin(), pending.end(),
+            [&](const shared_ptr<Job>& a, const shared_ptr<Job>& b) { return urgency(a) < urgency(b); });
+        if (best == pending.end()) {
+            // Wyjście odnotowane pod tą samą blokadą, pod którą submit() liczy działające
+            // zadania - żadne zgłoszenie nie zostanie bez zadania rozdzielającego.
+            if (--dispatchers == 0) {
+                dispatchersDone.notify_all();
+            }
+            return false;
+        }
+        job = *best;
+        chunk = job->nextChunk++;
+        if (job->nextChunk == job->chunks) {
+            pending.erase(best);
+        }
+    }
+
+    long long first = chunk * options.chunkSteps;
+    long long count = min(options.chunkSteps, job->request.steps - first);
+    double start = job->request.lower + first * job->stepSize;
+    calculatePartialIntegral(start, start + count * job->stepSize, count, job->stepSize, job->partials[chunk]);
+
+    if (job->finishedChunks.fetch_add(1, memory_order_acq_rel) + 1 == job->chunks) {
+        auto finished = chrono::steady_clock::now();
+        IntegrationOutcome outcome;
+        for (double partial : job->partials) {
+            outcome.pi += partial;
+        }
+        outcome.latencySeconds = chrono::duration<double>(finished - job->submitted).count();
+        outcome.deadlineMissed = finished > job->request.deadline;
+        outcome.priority = job->request.priority;
+        job->result.set_value(outcome);
+    }
+    return true;
+}
+
+int runPriorityMode(int argc, char* argv[]) {
+    long long largeSteps = max(1LL, getIntOption(argc, argv, "--large", 1000000000));
+    int largeJobs = static_cast<int>(max(0LL, getIntOption(argc, argv, "--large-jobs", 2)));
+    long long smallSteps = max(1LL, getIntOption(argc, argv, "--small", 1000000));
+    int smallJobs = static_cast<int>(max(0LL, getIntOption(argc, argv, "--small-jobs", 40)));
+    long long interval = max(0LL, getIntOption(argc, argv, "--interval", 25));
+    long long deadlineMs = max(1LL, getIntOption(argc, argv, "--deadline", 50));
+    long long chunkSteps = max(1LL, getIntOption(argc, argv, "--chunk", 1LL << 22));
+    int numThreads = static_cast<int>(getIntOption(argc, argv, "--threads", thread::hardware_concurrency()));
+
+    ThreadPool pool(static_cast<unsigned>(max(1, numThreads)));
+    cout << "Wątki: " << pool.size() << ", Duże: " << largeJobs << " × " << largeSteps << " kroków (niski priorytet), Małe: "
+        << smallJobs << " × " << smallSteps << " kroków co " << interval << " ms (wysoki priorytet, termin " << deadlineMs << " ms)" << endl;
+
+    auto runScenario = [&](const char* name, const SchedulerOptions& options) {
+        IntegrationScheduler scheduler(pool, options);
+        vector<future<IntegrationOutcome>> outcomes;
+        auto scenarioStart = chrono::steady_clock::now();
+        for (int i = 0; i < largeJobs; ++i) {
+            IntegrationRequest request;
+            request.steps = largeSteps;
+            request.priority = TaskPriority::Low;
+            outcomes.push_back(scheduler.submit(request));
+        }
+        for (int i = 0; i < smallJobs; ++i) {
+            this_thread::sleep_until(scenarioStart + chrono::milliseconds(interval * (i + 1)));
+            IntegrationRequest request;
+            request.steps = smallSteps;
+            request.priority = TaskPriority::High;
+            request.deadline = chrono::steady_clock::now() + chrono::milliseconds(deadlineMs);
+            outcomes.push_back(scheduler.submit(request));
+        }
+
+        // Opóźnienia pogrupowane według klasy priorytetu
+        vector<double> latencies[taskPriorityCount];
+        int missed[taskPriorityCount] = {};
+        for (auto& outcome : outcomes) {
+            IntegrationOutcome result = outcome.get();
+            latencies[static_cast<int>(result.priority)].push_back(result.latencySeconds);
+            missed[static_cast<int>(result.priority)] += result.deadlineMissed ? 1 : 0;
+        }
+        chrono::duration<double> total = chrono::steady_clock::now() - scenarioStart;
+        cout << "Szeregowanie: " << name << ", Czas całkowity: " << total.count() << "s" << endl;
+        for (int priority = 0; priority < taskPriorityCount; ++priority) {
+            vector<double>& values = latencies[priority];
+            if (values.empty()) {
+                continue;
+            }
+            sort(values.begin(), values.end());
+            double sum = 0.0;
+            for (double value : values) {
+                sum += value;
+            }
+            cout << "  Priorytet: " << taskPriorityName(static_cast<TaskPriority>(priority)) << ", Zadania: " << values.size()
+                << ", Opóźnienie średnie: " << sum / values.size() << "s, Mediana: " << values[values.size() / 2]
+                << "s, p99: " << values[min(values.size() - 1, values.size() * 99 / 100)] << "s, Maks.: " << values.back()
+                << "s, Przekroczone terminy: " << missed[priority] << endl;
+        }
+    };
+
+    SchedulerOptions fifo;
+    fifo.chunkSteps = max(largeSteps, smallSteps);
+    fifo.usePriorities = false;
+    runScenario("FIFO całych zadań", fifo);
+
+    SchedulerOptions chunked;
+    chunked.chunkSteps = chunkSteps;
+    runScenario("fragmenty + priorytety", chunked);
+    return 0;
+}
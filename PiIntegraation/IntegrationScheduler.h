@@ -0,0 +1,109 @@
+﻿/**
+ * @file IntegrationScheduler.h
+ * @brief Szeregowanie całkowań według priorytetu i terminu, z podziałem na fragmenty.
+ *
+ * Całkowanie 3e9 kroków trwa kilka sekund; wykonywane jako jedno zadanie puli
+ * blokuje wątek na cały ten czas i krótkie, pilne całkowania czekają za nim.
+ * IntegrationScheduler dzieli każde całkowanie na fragmenty po chunkSteps
+ * kroków. Planista utrzymuje w puli łącznie najwyżej pool.size() zadań
+ * rozdzielających (submit() nie blokuje się więc na pełnej kolejce puli,
+ * niezależnie od liczby całkowań w toku), a każde z nich pobiera kolejno
+ * najpilniejszy oczekujący fragment dowolnego całkowania, aż fragmenty się
+ * skończą: najpierw według klasy priorytetu, potem według
+ * terminu (najwcześniejszy termin pierwszy), potem według kolejności
+ * zgłoszenia. Zadania pilne wchodzą więc do obliczeń na granicy najbliższego fragmentu.
+ */
+
+#pragma once
+
+#include "ThreadPool.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * @brief Zgłoszenie całkowania \( \int_a^b \frac{4}{1 + x^2} dx \) metodą prostokątów.
+ */
+struct IntegrationRequest {
+    double lower = 0.0; ///< Dolna granica a.
+    double upper = 1.0; ///< Górna granica b.
+    long long steps = 0;
+    TaskPriority priority = TaskPriority::Normal;
+    /// Termin zakończenia (time_point::max() - brak terminu).
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+};
+
+/**
+ * @brief Wynik całkowania z opóźnieniem liczonym od zgłoszenia.
+ */
+struct IntegrationOutcome {
+    double pi = 0.0;              ///< Wartość całki (liczba PI dla przedziału [0, 1]).
+    double latencySeconds = 0.0;  ///< Od submit() do zakończenia ostatniego fragmentu.
+    bool deadlineMissed = false;
+    TaskPriority priority = TaskPriority::Normal;
+};
+
+/**
+ * @brief Opcje szeregowania.
+ */
+struct SchedulerOptions {
+    long long chunkSteps = 1LL << 22; ///< Kroki jednego fragmentu (granica wywłaszczenia).
+    bool usePriorities = true;        ///< false - kolejność zgłoszeń (FIFO), jak w zwykłej kolejce.
+};
+
+/**
+ * @brief Planista fragmentów całkowań wykonywanych w puli wątków.
+ *
+ * submit() można wywoływać z wielu wątków. Wynik sumowany jest w kolejności
+ * fragmentów, więc nie zależy od tego, które wątki je wykonały.
+ */
+class IntegrationScheduler {
+public:
+    IntegrationScheduler(ThreadPool& pool, const SchedulerOptions& options);
+
+    /// Czeka na zakończenie zadań rozdzielających, które jeszcze odwołują się do planisty.
+    ~IntegrationScheduler();
+
+    IntegrationScheduler(const IntegrationScheduler&) = delete;
+    IntegrationScheduler& operator=(const IntegrationScheduler&) = delete;
+
+    /// Zgłasza całkowanie; wynik jest dostępny przez zwrócony std::future.
+    std::future<IntegrationOutcome> submit(const IntegrationRequest& request);
+
+    /// Zgłasza całkowanie; \p result zostanie spełniona przez ostatni fragment.
+    void submit(const IntegrationRequest& request, std::promise<IntegrationOutcome> result);
+
+private:
+    struct Job;
+
+    /// Wykonuje najpilniejszy oczekujący fragment; false (i wyrejestrowanie zadania
+    /// rozdzielającego), jeśli nie ma żadnego.
+    bool runNextChunk();
+
+    ThreadPool& pool;
+    SchedulerOptions options;
+    std::mutex jobsMutex;
+    std::vector<std::shared_ptr<Job>> pending; ///< Całkowania z nieprzydzielonymi fragmentami.
+    long long dispatchers = 0;                 ///< Zadania rozdzielające w puli (chronione przez jobsMutex).
+    std::condition_variable dispatchersDone;
+    unsigned long long nextSequence = 0;
+};
+
+/**
+ * @brief Uruchamia tryb `priority` - opóźnienia pilnych całkowań obok dużych zadań tła.
+ *
+ * Scenariusz: `--large-jobs` całkowań po `--large` kroków (niski priorytet)
+ * oraz `--small-jobs` całkowań po `--small` kroków (wysoki priorytet, termin
+ * `--deadline` ms), zgłaszanych co `--interval` ms. Scenariusz jest wykonywany
+ * dwukrotnie: bez podziału i priorytetów (FIFO całych zadań) oraz z podziałem
+ * na fragmenty po `--chunk` kroków i priorytetami. Dla każdej klasy wypisywane
+ * są opóźnienia (średnie, mediana, p99, maksimum) i liczba przekroczonych terminów.
+ * Opcja `--threads n` ustala rozmiar puli.
+ *
+ * @return Kod zakończenia programu.
+ */
+int runPriorityMode(int argc, char* argv[]);
@@ -0,0 +1,102 @@
+﻿/**
+ * @file LatticeCounter.cpp
+ * @brief Implementacja zliczania punktów kratowych w kole.
+ */
+
+#include "LatticeCounter.h"
+#include "CommandLine.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+uint64_t integerSqrt(uint64_t n) {
+    // Przybliżenie zmiennoprzecinkowe poprawiane w arytmetyce całkowitej
+    uint64_t r = static_cast<uint64_t>(sqrt(static_cast<double>(n)));
+    while (r > 0 && r * r > n) {
+        --r;
+    }
+    while ((r + 1) * (r + 1) <= n) {
+        ++r;
+    }
+    return r;
+}
+
+namespace {
+
+/**
+ * @brief Suma \( \lfloor\sqrt{R^2 - x^2}\rfloor - x \) dla wierszy x z przedziału [first, last).
+ *
+ * Wartość \p slack = R² − x² − y² jest utrzymywana przyrostowo: przejście do
+ * kolejnego wiersza odejmuje 2x + 1, a obniżenie wysokości o jeden dodaje 2y − 1.
+ * Łączna liczba obniżeń w całej ósemce koła to około 0,29 R.
+ */
+uint64_t countRows(uint64_t radius, uint64_t first, uint64_t last) {
+    uint64_t squared = radius * radius;
+    uint64_t y = integerSqrt(squared - first * first);
+    int64_t slack = static_cast<int64_t>(squared - first * first - y * y);
+    uint64_t sum = 0;
+    for (uint64_t x = first; x < last; ++x) {
+        while (slack < 0) {
+            slack += static_cast<int64_t>(2 * y - 1);
+            --y;
+        }
+        sum += y - x;
+        slack -= static_cast<int64_t>(2 * x + 1);
+    }
+    return sum;
+}
+
+} // namespace
+
+uint64_t countLatticePoints(uint64_t radius, ThreadPool& pool) {
+    if (radius == 0) {
+        return 1;
+    }
+    // Wiersze 1..m, gdzie m = floor(R / sqrt(2)) to ostatni wiersz z punktem na przekątnej
+    uint64_t squared = radius * radius;
+    uint64_t diagonal = integerSqrt(squared / 2);
+
+    int chunks = static_cast<int>(pool.size()) * 16;
+    vector<uint64_t> partial(chunks, 0);
+    pool.parallelFor(static_cast<long long>(diagonal), chunks, [&](long long begin, long long end, int chunk) {
+        partial[chunk] = countRows(radius, static_cast<uint64_t>(begin) + 1, static_cast<uint64_t>(end) + 1);
+    });
+
+    // Ćwiartka (x, y >= 1): punkty na przekątnej + dwie symetryczne ósemki
+    uint64_t octant = 0;
+    for (uint64_t value : partial) {
+        octant += value;
+    }
+    uint64_t quadrant = diagonal + 2 * octant;
+
+    // Środek, cztery półosie i cztery ćwiartki
+    return 1 + 4 * radius + 4 * quadrant;
+}
+
+int runLatticeMode(int argc, char* argv[]) {
+    uint64_t radius = static_cast<uint64_t>(max(0LL, getIntOption(argc, argv, "--radius", 100000000)));
+    int numThreads = static_cast<int>(getIntOption(argc, argv, "--threads", thread::hardware_concurrency()));
+    if (radius > maxLatticeRadius) {
+        cerr << "Promień nie może przekraczać " << maxLatticeRadius << "." << endl;
+        return 1;
+    }
+
+    ThreadPool pool(static_cast<unsigned>(max(1, numThreads)));
+    auto startTime = chrono::high_resolution_clock::now();
+    uint64_t points = countLatticePoints(radius, pool);
+    auto endTime = chrono::high_resolution_clock::now();
+    chrono::duration<double> duration = endTime - startTime;
+
+    double pi = static_cast<double>(points) / (static_cast<double>(radius) * static_cast<double>(radius));
+    cout << "Promień: " << radius << ", Wątki: " << pool.size() << ", Czas: " << duration.count() << "s" << endl;
+    cout << "Punkty kratowe: " << points << endl;
+    cout << setprecision(15) << "PI: " << pi << ", Błąd: " << pi - 3.14159265358979323846 << endl;
+    return 0;
+}
@@ -0,0 +1,46 @@
+﻿/**
+ * @file LatticeCounter.h
+ * @brief Dokładne zliczanie punktów kratowych w kole (problem Gaussa) jako kontrola całkowania.
+ *
+ * Liczba punktów całkowitych \( N(R) \) spełniających \( x^2 + y^2 \le R^2 \) przybliża
+ * pole koła, więc \( \pi \approx N(R) / R^2 \). Zliczanie odbywa się wyłącznie
+ * w arytmetyce całkowitej, więc wynik nie zawiera błędów akumulacji
+ * zmiennoprzecinkowej - jedynym błędem jest błąd samej metody (rzędu \( R^{-3/2} \)).
+ */
+
+#pragma once
+
+#include <cstdint>
+
+class ThreadPool;
+
+/// Największy obsługiwany promień (2R² musi mieścić się w 64 bitach bez znaku).
+constexpr std::uint64_t maxLatticeRadius = 2000000000ULL;
+
+/**
+ * @brief Pierwiastek całkowity: największe r takie, że r * r <= n.
+ */
+std::uint64_t integerSqrt(std::uint64_t n);
+
+/**
+ * @brief Zlicza punkty kratowe w kole o promieniu \p radius.
+ *
+ * ### Wyjaśnienie działania:
+ * - Z symetrii wystarczy zliczyć jedną ósmą koła (wiersze 1 ≤ x ≤ R/√2).
+ * - Wiersze dzielone są na fragmenty wykonywane przez pulę wątków.
+ * - W obrębie fragmentu wysokość wiersza jest aktualizowana przyrostowo
+ *   (same dodawania liczb całkowitych), a pierwiastek liczony jest tylko
+ *   raz na początku fragmentu.
+ *
+ * @param radius Promień koła (co najwyżej maxLatticeRadius).
+ * @param pool Pula wątków wykonująca obliczenia.
+ * @return Liczba punktów kratowych \( N(R) \).
+ */
+std::uint64_t countLatticePoints(std::uint64_t radius, ThreadPool& pool);
+
+/**
+ * @brief Uruchamia tryb `lattice` (opcje: `--radius R`, `--threads n`).
+ *
+ * @return Kod zakończenia programu.
+ */
+int runLatticeMode(int argc, char* argv[]);
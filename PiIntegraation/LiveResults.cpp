@@ -0,0 +1,297 @@
+﻿/**
+ * @file LiveResults.cpp
+ * @brief Implementacja segmentu pamięci współdzielonej z wynikami przeglądu (Windows i POSIX).
+ */
+
+#include "LiveResults.h"
+#include "CommandLine.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <thread>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace {
+
+const char liveMagic[8] = { 'P', 'I', 'L', 'I', 'V', 'E', 0, 1 };
+
+size_t segmentSize(size_t rowCapacity, size_t workerCapacity) {
+    return sizeof(LiveHeader) + rowCapacity * sizeof(LiveRow) + workerCapacity * sizeof(LiveWorker);
+}
+
+/**
+ * @brief Odwzorowanie segmentu tylko do odczytu (po stronie czytelnika).
+ */
+class ReadOnlySegment {
+public:
+    explicit ReadOnlySegment(const string& name) {
+#ifdef _WIN32
+        handle = OpenFileMappingA(FILE_MAP_READ, FALSE, name.c_str());
+        if (handle == nullptr) {
+            return;
+        }
+        data = MapViewOfFile(handle, FILE_MAP_READ, 0, 0, 0);
+        MEMORY_BASIC_INFORMATION info;
+        if (data != nullptr && VirtualQuery(data, &info, sizeof(info)) != 0) {
+            bytes = info.RegionSize;
+        }
+#else
+        int descriptor = shm_open(name.c_str(), O_RDONLY, 0);
+        if (descriptor < 0) {
+            return;
+        }
+        struct stat status;
+        if (fstat(descriptor, &status) == 0 && status.st_size > 0) {
+            void* mapped = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_SHARED, descriptor, 0);
+            if (mapped != MAP_FAILED) {
+                data = mapped;
+                bytes = static_cast<size_t>(status.st_size);
+            }
+        }
+        close(descriptor);
+#endif
+    }
+
+    ~ReadOnlySegment() {
+#ifdef _WIN32
+        if (data != nullptr) {
+            UnmapViewOfFile(data);
+        }
+        if (handle != nullptr) {
+            CloseHandle(handle);
+        }
+#else
+        if (data != nullptr) {
+            munmap(data, bytes);
+        }
+#endif
+    }
+
+    void* data = nullptr;
+    size_t bytes = 0;
+#ifdef _WIN32
+    HANDLE handle = nullptr;
+#endif
+};
+
+} // namespace
+
+LiveResults::LiveResults(const string& name, size_t rowCapacity, int workerCapacity) : name(name) {
+    rowCapacity = max<size_t>(1, rowCapacity);
+    size_t workerSlots = static_cast<size_t>(max(1, workerCapacity));
+    size_t size = segmentSize(rowCapacity, workerSlots);
+#ifdef _WIN32
+    ULARGE_INTEGER large;
+    large.QuadPart = size;
+    HANDLE handle = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, large.HighPart, large.LowPart, name.c_str());
+    if (handle == nullptr) {
+        return;
+    }
+    mappingHandle = handle;
+    mapping = MapViewOfFile(handle, FILE_MAP_WRITE, 0, 0, size);
+    if (mapping == nullptr) {
+        return;
+    }
+#else
+    int descriptor = shm_open(name.c_str(), O_CREAT | O_RDWR, 0644);
+    if (descriptor < 0) {
+        return;
+    }
+    if (ftruncate(descriptor, static_cast<off_t>(size)) != 0) {
+        close(descriptor);
+        return;
+    }
+    void* mapped = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+    close(descriptor);
+    if (mapped == MAP_FAILED) {
+        return;
+    }
+    mapping = mapped;
+#endif
+    bytes = size;
+    memset(mapping, 0, size);
+
+    char* base = static_cast<char*>(mapping);
+    LiveHeader* created = new (base) LiveHeader{};
+    created->rowCapacity = static_cast<uint32_t>(rowCapacity);
+    created->workerCapacity = static_cast<uint32_t>(workerSlots);
+    rows = reinterpret_cast<LiveRow*>(base + sizeof(LiveHeader));
+    workers = new (base + sizeof(LiveHeader) + rowCapacity * sizeof(LiveRow)) LiveWorker[workerSlots]{};
+    // Magic na końcu - czytelnik nie przyjmie segmentu w trakcie inicjalizacji
+    atomic_thread_fence(memory_order_release);
+    memcpy(created->magic, liveMagic, sizeof(liveMagic));
+    header = created;
+}
+
+LiveResults::~LiveResults() {
+#ifdef _WIN32
+    if (mapping != nullptr) {
+        UnmapViewOfFile(mapping);
+    }
+    if (mappingHandle != nullptr) {
+        CloseHandle(mappingHandle);
+    }
+#else
+    if (mapping != nullptr) {
+        munmap(mapping, bytes);
+        shm_unlink(name.c_str());
+    }
+#endif
+}
+
+void LiveResults::beginWrite() {
+    header->sequence.store(header->sequence.load(memory_order_relaxed) + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+}
+
+void LiveResults::endWrite() {
+    header->sequence.store(header->sequence.load(memory_order_relaxed) + 1, memory_order_release);
+}
+
+void LiveResults::beginCell(long long steps, int threads) {
+    if (!header) {
+        return;
+    }
+    beginWrite();
+    header->cellSteps = steps;
+    header->cellThreads = threads;
+    header->cellStepsPerThread = threads > 0 ? steps / threads : 0;
+    endWrite();
+    for (uint32_t i = 0; i < header->workerCapacity; ++i) {
+        workers[i].done.store(0, memory_order_relaxed);
+    }
+}
+
+atomic<int64_t>* LiveResults::workerProgress(int worker) {
+    if (!header || worker < 0 || static_cast<uint32_t>(worker) >= header->workerCapacity) {
+        return nullptr;
+    }
+    return &workers[worker].done;
+}
+
+void LiveResults::publishRow(const SweepRow& row) {
+    if (!header) {
+        return;
+    }
+    beginWrite();
+    LiveRow& slot = rows[header->rowCount % header->rowCapacity];
+    slot.steps = row.steps;
+    slot.threads = row.threads;
+    slot.seconds = row.seconds;
+    slot.pi = row.pi;
+    ++header->rowCount;
+    endWrite();
+}
+
+void LiveResults::finish() {
+    if (!header) {
+        return;
+    }
+    beginWrite();
+    header->finished = 1;
+    endWrite();
+}
+
+bool readLiveSnapshot(const string& name, LiveSnapshot& snapshot) {
+    ReadOnlySegment segment(name);
+    if (segment.data == nullptr || segment.bytes < sizeof(LiveHeader)) {
+        return false;
+    }
+    const char* base = static_cast<const char*>(segment.data);
+    const LiveHeader* header = reinterpret_cast<const LiveHeader*>(base);
+    if (memcmp(header->magic, liveMagic, sizeof(liveMagic)) != 0) {
+        return false;
+    }
+    atomic_thread_fence(memory_order_acquire);
+    size_t rowCapacity = header->rowCapacity;
+    size_t workerCapacity = header->workerCapacity;
+    if (segment.bytes < segmentSize(rowCapacity, workerCapacity)) {
+        return false;
+    }
+    const LiveRow* rows = reinterpret_cast<const LiveRow*>(base + sizeof(LiveHeader));
+    const LiveWorker* workers = reinterpret_cast<const LiveWorker*>(base + sizeof(LiveHeader) + rowCapacity * sizeof(LiveRow));
+
+    for (;;) {
+        uint64_t before = header->sequence.load(memory_order_acquire);
+        if (before % 2 != 0) {
+            this_thread::yield();
+            continue;
+        }
+        snapshot.steps = header->cellSteps;
+        snapshot.threads = header->cellThreads;
+        snapshot.finished = header->finished != 0;
+        snapshot.stepsPerThread = header->cellStepsPerThread;
+        snapshot.rowCount = header->rowCount;
+        size_t available = static_cast<size_t>(min<uint64_t>(snapshot.rowCount, rowCapacity));
+        snapshot.rows.resize(available);
+        for (size_t i = 0; i < available; ++i) {
+            const LiveRow& row = rows[(snapshot.rowCount - available + i) % rowCapacity];
+            snapshot.rows[i] = { row.steps, row.threads, row.seconds, row.pi };
+        }
+        atomic_thread_fence(memory_order_acquire);
+        if (header->sequence.load(memory_order_relaxed) == before) {
+            break;
+        }
+    }
+
+    // Liczniki wątków są niezależnymi wartościami atomowymi - nie wymagają seqlocka
+    size_t workerCount = min<size_t>(static_cast<size_t>(max(0, snapshot.threads)), workerCapacity);
+    snapshot.workerDone.resize(workerCount);
+    for (size_t i = 0; i < workerCount; ++i) {
+        snapshot.workerDone[i] = workers[i].done.load(memory_order_relaxed);
+    }
+    return true;
+}
+
+int runLiveMode(int argc, char* argv[]) {
+    string name = getOption(argc, argv, "--name", defaultLiveSegment);
+    long long interval = max(10LL, getIntOption(argc, argv, "--interval", 1000));
+    bool once = hasFlag(argc, argv, "--once");
+
+    LiveSnapshot snapshot;
+    if (!readLiveSnapshot(name, snapshot)) {
+        cerr << "Brak segmentu pamięci współdzielonej " << name << " (czy przegląd jest uruchomiony?)." << endl;
+        return 1;
+    }
+    for (;;) {
+        cout << "Komórka: " << snapshot.steps << " kroków, " << snapshot.threads << " wątków, Wiersze: " << snapshot.rowCount;
+        if (!snapshot.workerDone.empty() && snapshot.stepsPerThread > 0) {
+            cout << ", Postęp wątków (%):";
+            for (long long done : snapshot.workerDone) {
+                cout << " " << 100 * done / snapshot.stepsPerThread;
+            }
+        }
+        cout << endl;
+        if (!snapshot.rows.empty()) {
+            const SweepRow& last = snapshot.rows.back();
+            cout << "  Ostatni wynik - Liczba kroków: " << last.steps << ", Wątki: " << last.threads
+                << ", Czas: " << last.seconds << "s, PI: " << last.pi << endl;
+        }
+        if (snapshot.finished) {
+            cout << "Przegląd zakończony." << endl;
+            return 0;
+        }
+        if (once) {
+            return 0;
+        }
+        this_thread::sleep_for(chrono::milliseconds(interval));
+        if (!readLiveSnapshot(name, snapshot)) {
+            cout << "Segment " << name << " został usunięty - przegląd zakończony." << endl;
+            return 0;
+        }
+    }
+}
@@ -0,0 +1,139 @@
+﻿/**
+ * @file LiveResults.h
+ * @brief Publikacja bieżących wyników przeglądu w pamięci współdzielonej.
+ *
+ * Zewnętrzne programy monitorujące mogą odczytywać postęp przeglądu bez
+ * parsowania plików: tabela wyników i bieżąca komórka są umieszczone
+ * w nazwanym segmencie pamięci współdzielonej (POSIX shm_open / nazwane
+ * odwzorowanie Windows) i chronione blokadą sekwencyjną (seqlock) - jedynym
+ * piszącym jest wątek sterujący przeglądem, a czytelnicy nigdy go nie blokują.
+ * Postęp każdego wątku roboczego to osobny licznik w swojej linii pamięci
+ * podręcznej, zapisywany przez ten wątek co blok kroków.
+ *
+ * Układ segmentu (natywna kolejność bajtów):
+ * - LiveHeader,
+ * - rowCapacity × LiveRow (bufor cykliczny ostatnich wierszy),
+ * - workerCapacity × LiveWorker.
+ *
+ * Protokół czytelnika: odczytaj sequence (nieparzysta - trwa zapis, ponów),
+ * skopiuj dane, odczytaj sequence ponownie - różna wartość oznacza, że kopię
+ * trzeba powtórzyć. Przykładowym czytelnikiem jest tryb `live`.
+ */
+
+#pragma once
+
+#include "ResultsWriter.h"
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// Domyślna nazwa segmentu pamięci współdzielonej.
+#ifdef _WIN32
+constexpr const char* defaultLiveSegment = "Local\\pi_live";
+#else
+constexpr const char* defaultLiveSegment = "/pi_live";
+#endif
+
+/**
+ * @brief Nagłówek segmentu; pola poza magic i pojemnościami chroni sequence.
+ */
+struct LiveHeader {
+    char magic[8];                      ///< "PILIVE\0\1".
+    std::uint32_t rowCapacity;
+    std::uint32_t workerCapacity;
+    std::atomic<std::uint64_t> sequence; ///< Licznik seqlocka (nieparzysty w trakcie zapisu).
+    std::uint64_t rowCount;             ///< Liczba opublikowanych wierszy (także nadpisanych).
+    std::int64_t cellSteps;             ///< Bieżąca komórka: liczba kroków.
+    std::int32_t cellThreads;           ///< Bieżąca komórka: liczba wątków.
+    std::int32_t finished;              ///< 1 po zakończeniu przeglądu.
+    std::int64_t cellStepsPerThread;    ///< Kroki jednego wątku w bieżącej komórce.
+};
+
+/// Wiersz tabeli wyników w segmencie.
+struct LiveRow {
+    std::int64_t steps;
+    std::int32_t threads;
+    std::int32_t reserved;
+    double seconds;
+    double pi;
+};
+
+/// Postęp jednego wątku roboczego (osobna linia pamięci podręcznej - brak fałszywego współdzielenia).
+struct alignas(64) LiveWorker {
+    std::atomic<std::int64_t> done; ///< Wykonane kroki w bieżącej komórce.
+};
+
+/**
+ * @brief Kopia stanu segmentu wykonana przez czytelnika.
+ */
+struct LiveSnapshot {
+    long long steps = 0;
+    int threads = 0;
+    bool finished = false;
+    long long stepsPerThread = 0;
+    std::uint64_t rowCount = 0;
+    std::vector<SweepRow> rows;       ///< Ostatnie wiersze (najwyżej rowCapacity).
+    std::vector<long long> workerDone; ///< Postęp wątków bieżącej komórki.
+};
+
+/**
+ * @brief Właściciel segmentu - tworzy go, publikuje dane i usuwa nazwę w destruktorze.
+ *
+ * beginCell(), publishRow() i finish() wywołuje jeden wątek. Każda z nich to
+ * kilka zapisów do pamięci, bez wywołań systemowych.
+ */
+class LiveResults {
+public:
+    LiveResults(const std::string& name = defaultLiveSegment, std::size_t rowCapacity = 4096, int workerCapacity = 256);
+    ~LiveResults();
+
+    LiveResults(const LiveResults&) = delete;
+    LiveResults& operator=(const LiveResults&) = delete;
+
+    /// Czy segment został utworzony.
+    bool isOpen() const { return header != nullptr; }
+
+    /// Ogłasza rozpoczęcie komórki i zeruje postęp wątków.
+    void beginCell(long long steps, int threads);
+
+    /// Licznik postępu wątku \p worker lub nullptr, jeśli wątków jest więcej niż miejsc.
+    std::atomic<std::int64_t>* workerProgress(int worker);
+
+    /// Dopisuje wiersz wyników.
+    void publishRow(const SweepRow& row);
+
+    /// Oznacza przegląd jako zakończony.
+    void finish();
+
+private:
+    void beginWrite();
+    void endWrite();
+
+    std::string name;
+    void* mapping = nullptr;
+    std::size_t bytes = 0;
+    LiveHeader* header = nullptr;
+    LiveRow* rows = nullptr;
+    LiveWorker* workers = nullptr;
+#ifdef _WIN32
+    void* mappingHandle = nullptr;
+#endif
+};
+
+/**
+ * @brief Spójna kopia segmentu \p name (zgodnie z protokołem seqlocka).
+ * @return false, jeśli segment nie istnieje lub ma nieprawidłowy format.
+ */
+bool readLiveSnapshot(const std::string& name, LiveSnapshot& snapshot);
+
+/**
+ * @brief Uruchamia tryb `live` - podgląd przeglądu wykonywanego przez inny proces.
+ *
+ * Co `--interval ms` (domyślnie 1000) wypisuje bieżącą komórkę, postęp wątków
+ * i ostatni wynik, aż przegląd się zakończy. Opcje: `--name segment`, `--once`.
+ *
+ * @return Kod zakończenia programu.
+ */
+int runLiveMode(int argc, char* argv[]);
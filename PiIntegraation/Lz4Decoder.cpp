@@ -0,0 +1,213 @@
+﻿/**
+ * @file Lz4Decoder.cpp
+ * @brief Implementacja czytnika ramek LZ4 i dekompresji bloków.
+ */
+
+#include "Lz4Decoder.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+using namespace std;
+
+namespace {
+
+constexpr uint32_t lz4Magic = 0x184D2204;
+constexpr uint32_t zstdMagic = 0xFD2FB528;
+constexpr uint32_t skippableMagicMask = 0xFFFFFFF0;
+constexpr uint32_t skippableMagic = 0x184D2A50;
+
+/// Odczytuje liczbę 32-bitową zapisaną w kolejności little-endian.
+bool readUint32(FILE* input, uint32_t& value) {
+    unsigned char bytes[4];
+    if (fread(bytes, 1, 4, input) != 4) {
+        return false;
+    }
+    value = bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (static_cast<uint32_t>(bytes[3]) << 24);
+    return true;
+}
+
+/// Pomija \p count bajtów odczytem (fseek nie działa na potokach, np. standardowym wejściu).
+bool skipBytes(FILE* input, uint64_t count) {
+    char scratch[4096];
+    while (count > 0) {
+        size_t chunk = static_cast<size_t>(min<uint64_t>(count, sizeof(scratch)));
+        if (fread(scratch, 1, chunk, input) != chunk) {
+            return false;
+        }
+        count -= chunk;
+    }
+    return true;
+}
+
+} // namespace
+
+Lz4FrameReader::Lz4FrameReader(FILE* input) : input(input) {
+}
+
+bool Lz4FrameReader::fail(const string& message) {
+    errorMessage = message;
+    return false;
+}
+
+bool Lz4FrameReader::readFrameHeader() {
+    uint32_t magic = 0;
+    while (true) {
+        if (!readUint32(input, magic)) {
+            return false; // Koniec pliku między ramkami
+        }
+        if ((magic & skippableMagicMask) != skippableMagic) {
+            break;
+        }
+        uint32_t size = 0;
+        if (!readUint32(input, size) || !skipBytes(input, size)) {
+            return fail("Uszkodzona ramka pomijalna.");
+        }
+    }
+    if (magic == zstdMagic) {
+        return fail("Format zstd nie jest obsługiwany - użyj plików .lz4.");
+    }
+    if (magic != lz4Magic) {
+        return fail("Nieznany format danych skompresowanych.");
+    }
+
+    unsigned char descriptor[2];
+    if (fread(descriptor, 1, 2, input) != 2) {
+        return fail("Niekompletny nagłówek ramki LZ4.");
+    }
+    unsigned char flags = descriptor[0];
+    if ((flags >> 6) != 1) {
+        return fail("Nieobsługiwana wersja ramki LZ4.");
+    }
+    if ((flags & 0x20) == 0) {
+        return fail("Bloki zależne nie mogą być dekompresowane równolegle (użyj lz4 -BI).");
+    }
+    if (flags & 0x01) {
+        return fail("Słowniki LZ4 nie są obsługiwane.");
+    }
+    blockChecksum = (flags & 0x10) != 0;
+    contentChecksum = (flags & 0x04) != 0;
+
+    int sizeCode = (descriptor[1] >> 4) & 0x7;
+    if (sizeCode < 4) {
+        return fail("Niepoprawny maksymalny rozmiar bloku LZ4.");
+    }
+    blockMaxSize = size_t(1) << (8 + 2 * sizeCode); // 4: 64 KB, 5: 256 KB, 6: 1 MB, 7: 4 MB
+
+    // Pominięcie rozmiaru zawartości (opcjonalnie) i bajtu sumy kontrolnej nagłówka
+    uint64_t skip = ((flags & 0x08) ? 8 : 0) + 1;
+    if (!skipBytes(input, skip)) {
+        return fail("Niekompletny nagłówek ramki LZ4.");
+    }
+    inFrame = true;
+    return true;
+}
+
+bool Lz4FrameReader::next(Lz4Block& block) {
+    while (true) {
+        if (!inFrame && !readFrameHeader()) {
+            return false;
+        }
+
+        uint32_t header = 0;
+        if (!readUint32(input, header)) {
+            return fail("Niekompletny blok LZ4.");
+        }
+        if (header == 0) {
+            // Znacznik końca ramki, opcjonalnie z sumą kontrolną zawartości
+            inFrame = false;
+            if (contentChecksum && !skipBytes(input, 4)) {
+                return fail("Brak sumy kontrolnej ramki LZ4.");
+            }
+            continue;
+        }
+
+        size_t size = header & 0x7FFFFFFF;
+        if (size > blockMaxSize) {
+            return fail("Blok LZ4 przekracza maksymalny rozmiar.");
+        }
+        block.index = blockIndex++;
+        block.compressed = (header & 0x80000000) == 0;
+        block.maxSize = blockMaxSize;
+        block.data.resize(size);
+        if (fread(block.data.data(), 1, size, input) != size) {
+            return fail("Niekompletny blok LZ4.");
+        }
+        if (blockChecksum && !skipBytes(input, 4)) {
+            return fail("Brak sumy kontrolnej bloku LZ4.");
+        }
+        return true;
+    }
+}
+
+long long decompressLz4Block(const char* source, size_t sourceSize, char* destination, size_t capacity) {
+    const unsigned char* ip = reinterpret_cast<const unsigned char*>(source);
+    const unsigned char* sourceEnd = ip + sourceSize;
+    char* op = destination;
+    char* destinationEnd = destination + capacity;
+
+    while (ip < sourceEnd) {
+        unsigned token = *ip++;
+
+        // Literały
+        size_t literalLength = token >> 4;
+        if (literalLength == 15) {
+            unsigned char extra;
+            do {
+                if (ip >= sourceEnd) {
+                    return -1;
+                }
+                extra = *ip++;
+                literalLength += extra;
+            } while (extra == 255);
+        }
+        if (literalLength > static_cast<size_t>(sourceEnd - ip) || literalLength > static_cast<size_t>(destinationEnd - op)) {
+            return -1;
+        }
+        memcpy(op, ip, literalLength);
+        ip += literalLength;
+        op += literalLength;
+        if (ip == sourceEnd) {
+            break; // Ostatnia sekwencja zawiera tylko literały
+        }
+
+        // Dopasowanie: przesunięcie wstecz i długość
+        if (sourceEnd - ip < 2) {
+            return -1;
+        }
+        size_t offset = ip[0] | (ip[1] << 8);
+        ip += 2;
+        if (offset == 0 || offset > static_cast<size_t>(op - destination)) {
+            return -1;
+        }
+        size_t matchLength = token & 15;
+        if (matchLength == 15) {
+            unsigned char extra;
+            do {
+                if (ip >= sourceEnd) {
+                    return -1;
+                }
+                extra = *ip++;
+                matchLength += extra;
+            } while (extra == 255);
+        }
+        matchLength += 4;
+        if (matchLength > static_cast<size_t>(destinationEnd - op)) {
+            return -1;
+        }
+
+        const char* match = op - offset;
+        if (offset >= matchLength) {
+            memcpy(op, match, matchLength);
+        }
+        else {
+            // Nakładające się kopiowanie powtarza ostatnie bajty - kopiujemy po jednym bajcie
+            for (size_t i = 0; i < matchLength; ++i) {
+                op[i] = match[i];
+            }
+        }
+        op += matchLength;
+    }
+    return op - destination;
+}
@@ -0,0 +1,67 @@
+﻿/**
+ * @file Lz4Decoder.h
+ * @brief Odczyt ramek LZ4 i dekompresja pojedynczych bloków LZ4.
+ *
+ * Czytnik ramek dzieli plik .lz4 na bloki, które przy niezależnych blokach
+ * (domyślne ustawienie programu `lz4`) mogą być dekompresowane równolegle.
+ * Sumy kontrolne xxHash są pomijane, a nie weryfikowane.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Jeden blok danych odczytany z ramki LZ4.
+ */
+struct Lz4Block {
+    long long index = 0;        ///< Numer kolejny bloku w pliku.
+    bool compressed = true;     ///< false, jeśli blok zapisano bez kompresji.
+    std::size_t maxSize = 0;    ///< Maksymalny rozmiar bloku po dekompresji.
+    std::vector<char> data;     ///< Dane bloku w postaci z pliku.
+};
+
+/**
+ * @brief Sekwencyjny czytnik ramek LZ4 z pliku.
+ */
+class Lz4FrameReader {
+public:
+    /// Rozpoczyna odczyt z otwartego pliku \p input.
+    explicit Lz4FrameReader(std::FILE* input);
+
+    /**
+     * @brief Odczytuje kolejny blok danych (także z następnych ramek w pliku).
+     * @param block Blok wynikowy.
+     * @return false na końcu pliku lub przy błędzie (patrz error()).
+     */
+    bool next(Lz4Block& block);
+
+    /// Opis błędu formatu; pusty, jeśli plik zakończył się poprawnie.
+    const std::string& error() const { return errorMessage; }
+
+private:
+    bool readFrameHeader();
+    bool fail(const std::string& message);
+
+    std::FILE* input;
+    bool inFrame = false;
+    bool blockChecksum = false;
+    bool contentChecksum = false;
+    std::size_t blockMaxSize = 0;
+    long long blockIndex = 0;
+    std::string errorMessage;
+};
+
+/**
+ * @brief Dekompresuje pojedynczy blok w formacie LZ4 block.
+ *
+ * @param source Dane skompresowane.
+ * @param sourceSize Rozmiar danych skompresowanych.
+ * @param destination Bufor wynikowy.
+ * @param capacity Pojemność bufora wynikowego.
+ * @return Liczba zdekompresowanych bajtów lub -1 przy uszkodzonych danych.
+ */
+long long decompressLz4Block(const char* source, std::size_t sourceSize, char* destination, std::size_t capacity);
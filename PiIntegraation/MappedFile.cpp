@@ -0,0 +1,83 @@
+﻿/**
+ * @file MappedFile.cpp
+ * @brief Implementacja odwzorowania pliku w pamięci dla Windows i systemów POSIX.
+ */
+
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const string& path, size_t bytes) {
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr,
+        CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return;
+    }
+    fileHandle = file;
+    if (bytes == 0) {
+        return; // Pustego pliku nie da się odwzorować
+    }
+
+    ULARGE_INTEGER size;
+    size.QuadPart = bytes;
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READWRITE, size.HighPart, size.LowPart, nullptr);
+    if (mapping == nullptr) {
+        return;
+    }
+    mappingHandle = mapping;
+    data = MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, bytes);
+    this->bytes = data != nullptr ? bytes : 0;
+}
+
+MappedFile::~MappedFile() {
+    if (data != nullptr) {
+        FlushViewOfFile(data, 0);
+        UnmapViewOfFile(data);
+    }
+    if (mappingHandle != nullptr) {
+        CloseHandle(mappingHandle);
+    }
+    if (fileHandle != nullptr) {
+        CloseHandle(fileHandle);
+    }
+}
+
+#else
+
+MappedFile::MappedFile(const string& path, size_t bytes) {
+    fileDescriptor = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fileDescriptor < 0 || bytes == 0) {
+        return;
+    }
+    if (ftruncate(fileDescriptor, static_cast<off_t>(bytes)) != 0) {
+        return;
+    }
+    void* mapped = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fileDescriptor, 0);
+    if (mapped == MAP_FAILED) {
+        return;
+    }
+    data = mapped;
+    this->bytes = bytes;
+}
+
+MappedFile::~MappedFile() {
+    if (data != nullptr) {
+        munmap(data, bytes);
+    }
+    if (fileDescriptor >= 0) {
+        close(fileDescriptor);
+    }
+}
+
+#endif
@@ -0,0 +1,51 @@
+﻿/**
+ * @file MappedFile.h
+ * @brief Plik wyjściowy odwzorowany w pamięci (Windows i POSIX).
+ *
+ * Duże tablice wyników (np. całka narastająca w każdym punkcie siatki) są
+ * zapisywane bezpośrednio do odwzorowanego pliku, bez pośredniego bufora
+ * i bez wywołań zapisu dla każdego elementu.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+/**
+ * @brief Plik o zadanym rozmiarze odwzorowany w pamięci do zapisu.
+ *
+ * Podobnie jak std::ofstream, poprawność otwarcia sprawdza się metodą is_open().
+ */
+class MappedFile {
+public:
+    /**
+     * @brief Tworzy (lub nadpisuje) plik o rozmiarze \p bytes i odwzorowuje go w pamięci.
+     * @param path Ścieżka pliku.
+     * @param bytes Rozmiar pliku w bajtach.
+     */
+    MappedFile(const std::string& path, std::size_t bytes);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /// Czy plik został poprawnie utworzony i odwzorowany.
+    bool is_open() const { return data != nullptr; }
+
+    /// Początek odwzorowanego obszaru.
+    void* get() const { return data; }
+
+    /// Rozmiar odwzorowanego obszaru w bajtach.
+    std::size_t size() const { return bytes; }
+
+private:
+    void* data = nullptr;
+    std::size_t bytes = 0;
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#else
+    int fileDescriptor = -1;
+#endif
+};
@@ -0,0 +1,520 @@
+﻿/**
+ * @file MonteCarlo.cpp
+ * @brief Implementacja zwykłej metody Monte Carlo oraz algorytmów VEGAS i MISER.
+ */
+
+#include "MonteCarlo.h"
+#include "CommandLine.h"
+#include "CounterRng.h"
+#include "Integration.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+
+using namespace std;
+
+namespace {
+
+/// Stała liczba fragmentów próbek - kolejność sumowania nie zależy od liczby wątków.
+constexpr int sampleChunks = 128;
+
+/// Szerokość piku funkcji `gauss`.
+constexpr double gaussWidth = 0.1;
+
+/**
+ * @brief Sumy zebrane przez jeden fragment próbek.
+ */
+struct ChunkSums {
+    double sum = 0.0;
+    double sumSquares = 0.0;
+    vector<double> histogram; ///< f² w przedziałach siatki, wymiar po wymiarze (tylko VEGAS).
+};
+
+/// Średnia i odchylenie standardowe średniej z sum fragmentów.
+void combineChunks(const vector<ChunkSums>& chunks, long long samples, double& mean, double& error) {
+    double sum = 0.0, sumSquares = 0.0;
+    for (const ChunkSums& chunk : chunks) {
+        sum += chunk.sum;
+        sumSquares += chunk.sumSquares;
+    }
+    double n = static_cast<double>(samples);
+    mean = sum / n;
+    double variance = max(0.0, sumSquares / n - mean * mean);
+    error = samples > 1 ? sqrt(variance / (n - 1.0)) : 0.0;
+}
+
+/**
+ * @brief Separowalna siatka VEGAS: granice przedziałów w każdym wymiarze.
+ */
+class VegasGrid {
+public:
+    VegasGrid(int dimensions, int bins) : dimensions(dimensions), bins(bins), edges(dimensions * (bins + 1)) {
+        for (int d = 0; d < dimensions; ++d) {
+            for (int i = 0; i <= bins; ++i) {
+                edges[d * (bins + 1) + i] = static_cast<double>(i) / bins;
+            }
+        }
+    }
+
+    /**
+     * @brief Odwzorowuje punkt jednostajny \p y na punkt siatki \p x.
+     *
+     * @param binIndices Numery przedziałów w każdym wymiarze (do histogramu).
+     * @return Jakobian odwzorowania (waga próbki).
+     */
+    double map(const double* y, double* x, int* binIndices) const {
+        double jacobian = 1.0;
+        for (int d = 0; d < dimensions; ++d) {
+            double position = y[d] * bins;
+            int bin = min(static_cast<int>(position), bins - 1);
+            const double* edge = &edges[d * (bins + 1) + bin];
+            double width = edge[1] - edge[0];
+            x[d] = edge[0] + (position - bin) * width;
+            jacobian *= width * bins;
+            binIndices[d] = bin;
+        }
+        return jacobian;
+    }
+
+    /**
+     * @brief Przesuwa granice w wymiarze \p d według histogramu \p weights (f² w przedziałach).
+     *
+     * Histogram jest wygładzany, a udziały kompresowane wykładnikiem \p alpha,
+     * aby siatka nie zmieniała się skokowo między iteracjami.
+     */
+    void refine(int d, const double* weights, double alpha) {
+        vector<double> smoothed(bins);
+        for (int i = 0; i < bins; ++i) {
+            int from = max(0, i - 1), to = min(bins - 1, i + 1);
+            double sum = 0.0;
+            for (int j = from; j <= to; ++j) {
+                sum += weights[j];
+            }
+            smoothed[i] = sum / (to - from + 1);
+        }
+        double total = 0.0;
+        for (double value : smoothed) {
+            total += value;
+        }
+        if (total <= 0.0 || bins < 2) {
+            return;
+        }
+
+        vector<double> importance(bins);
+        double importanceTotal = 0.0;
+        for (int i = 0; i < bins; ++i) {
+            double share = smoothed[i] / total;
+            importance[i] = share > 0.0 && share < 1.0 ? pow((share - 1.0) / log(share), alpha) : share;
+            importanceTotal += importance[i];
+        }
+
+        // Nowe granice dzielą łączną ważność na równe części
+        double* edge = &edges[d * (bins + 1)];
+        vector<double> updated(bins + 1);
+        updated[0] = 0.0;
+        updated[bins] = 1.0;
+        double perBin = importanceTotal / bins;
+        double accumulated = 0.0;
+        int old = 0;
+        for (int i = 1; i < bins; ++i) {
+            double target = perBin * i;
+            while (old < bins - 1 && accumulated + importance[old] <= target) {
+                accumulated += importance[old];
+                ++old;
+            }
+            double fraction = importance[old] > 0.0 ? min(1.0, (target - accumulated) / importance[old]) : 0.0;
+            updated[i] = edge[old] + fraction * (edge[old + 1] - edge[old]);
+        }
+        copy(updated.begin(), updated.end(), edge);
+    }
+
+private:
+    int dimensions;
+    int bins;
+    vector<double> edges;
+};
+
+/// Od tej liczby próbek połówki obszaru MISER liczone są równolegle.
+constexpr long long miserParallelSamples = 20000;
+
+/// Dodawane do numeru obszaru w kluczu generatora (stała złotego podziału).
+constexpr uint64_t regionKeyStep = 0x9E3779B97F4A7C15ULL;
+
+/// Fazy próbkowania obszaru MISER - osobne strumienie generatora.
+enum MiserStream : uint32_t { explorationStream = 1, estimateStream = 2, ditherStream = 3 };
+
+/**
+ * @brief Średnia funkcji w obszarze i wariancja tej średniej.
+ */
+struct RegionEstimate {
+    double mean = 0.0;
+    double variance = 0.0;
+    long long evaluations = 0;
+};
+
+/**
+ * @brief Obszar prostopadłościenny [lower, upper) z numerem w drzewie podziałów (korzeń = 1).
+ */
+struct Region {
+    vector<double> lower;
+    vector<double> upper;
+    uint64_t id = 1;
+};
+
+void sampleRegion(const Region& region, CounterRng& rng, double* x) {
+    for (size_t d = 0; d < region.lower.size(); ++d) {
+        x[d] = region.lower[d] + rng.uniform() * (region.upper[d] - region.lower[d]);
+    }
+}
+
+RegionEstimate miserRegion(const Integrand& integrand, const MiserOptions& options, ThreadPool& pool,
+    const Region& region, long long samples) {
+    int dimensions = integrand.dimensions;
+    uint64_t key = options.seed + region.id * regionKeyStep;
+    vector<double> x(dimensions);
+    RegionEstimate estimate;
+
+    // Mały obszar - zwykła metoda Monte Carlo
+    if (samples < options.minBisect) {
+        double sum = 0.0, sumSquares = 0.0;
+        for (long long i = 0; i < samples; ++i) {
+            CounterRng rng(key, estimateStream, static_cast<uint64_t>(i));
+            sampleRegion(region, rng, x.data());
+            double value = integrand.function(x.data());
+            sum += value;
+            sumSquares += value * value;
+        }
+        double n = static_cast<double>(max(1LL, samples));
+        estimate.mean = sum / n;
+        estimate.variance = max(0.0, sumSquares / n - estimate.mean * estimate.mean) / n;
+        estimate.evaluations = samples;
+        return estimate;
+    }
+
+    // Rozpoznanie: zakres wartości funkcji po obu stronach (przesuniętego) środka w każdym wymiarze
+    CounterRng ditherRng(key, ditherStream, 0);
+    vector<double> middle(dimensions);
+    for (int d = 0; d < dimensions; ++d) {
+        double offset = options.dither * (2.0 * ditherRng.uniform() - 1.0);
+        middle[d] = region.lower[d] + (0.5 + offset) * (region.upper[d] - region.lower[d]);
+    }
+    const double infinity = numeric_limits<double>::infinity();
+    vector<double> leftMin(dimensions, infinity), leftMax(dimensions, -infinity);
+    vector<double> rightMin(dimensions, infinity), rightMax(dimensions, -infinity);
+    long long exploration = max(options.minPoints, static_cast<long long>(samples * options.explorationFraction));
+    for (long long i = 0; i < exploration; ++i) {
+        CounterRng rng(key, explorationStream, static_cast<uint64_t>(i));
+        sampleRegion(region, rng, x.data());
+        double value = integrand.function(x.data());
+        for (int d = 0; d < dimensions; ++d) {
+            if (x[d] <= middle[d]) {
+                leftMin[d] = min(leftMin[d], value);
+                leftMax[d] = max(leftMax[d], value);
+            }
+            else {
+                rightMin[d] = min(rightMin[d], value);
+                rightMax[d] = max(rightMax[d], value);
+            }
+        }
+    }
+
+    // Wymiar podziału minimalizujący σ_l^(2/3) + σ_r^(2/3)
+    const double tiny = 1e-30;
+    int bestDimension = -1;
+    double bestSum = infinity, leftSigma = 1.0, rightSigma = 1.0;
+    for (int d = 0; d < dimensions; ++d) {
+        if (leftMax[d] < leftMin[d] || rightMax[d] < rightMin[d]) {
+            continue;
+        }
+        double left = max(tiny, pow(leftMax[d] - leftMin[d], 2.0 / 3.0));
+        double right = max(tiny, pow(rightMax[d] - rightMin[d], 2.0 / 3.0));
+        if (left + right < bestSum) {
+            bestSum = left + right;
+            bestDimension = d;
+            leftSigma = left;
+            rightSigma = right;
+        }
+    }
+    if (bestDimension < 0) {
+        bestDimension = static_cast<int>(region.id % static_cast<uint64_t>(dimensions));
+    }
+
+    // Podział pozostałych próbek proporcjonalnie do udziału objętości i zmienności połówek
+    double width = region.upper[bestDimension] - region.lower[bestDimension];
+    double leftFraction = (middle[bestDimension] - region.lower[bestDimension]) / width;
+    long long remaining = samples - exploration;
+    double leftShare = leftFraction * leftSigma / (leftFraction * leftSigma + (1.0 - leftFraction) * rightSigma);
+    long long leftSamples = options.minPoints
+        + static_cast<long long>(max(0LL, remaining - 2 * options.minPoints) * leftShare);
+    long long halfSamples[2] = { leftSamples, remaining - leftSamples };
+
+    Region halves[2] = { region, region };
+    halves[0].upper[bestDimension] = middle[bestDimension];
+    halves[0].id = 2 * region.id;
+    halves[1].lower[bestDimension] = middle[bestDimension];
+    halves[1].id = 2 * region.id + 1;
+
+    RegionEstimate results[2];
+    auto computeHalf = [&](int half) {
+        results[half] = miserRegion(integrand, options, pool, halves[half], halfSamples[half]);
+    };
+    if (samples >= miserParallelSamples) {
+        pool.parallelFor(2, 2, [&](long long begin, long long, int) { computeHalf(static_cast<int>(begin)); });
+    }
+    else {
+        computeHalf(0);
+        computeHalf(1);
+    }
+
+    estimate.mean = leftFraction * results[0].mean + (1.0 - leftFraction) * results[1].mean;
+    estimate.variance = leftFraction * leftFraction * results[0].variance
+        + (1.0 - leftFraction) * (1.0 - leftFraction) * results[1].variance;
+    estimate.evaluations = exploration + results[0].evaluations + results[1].evaluations;
+    return estimate;
+}
+
+} // namespace
+
+Integrand monteCarloIntegrand(const string& name, int dimensions) {
+    Integrand integrand;
+    integrand.name = name;
+    if (name == "pi") {
+        integrand.dimensions = 1;
+        integrand.function = [](const double* x) { return f(x[0]); };
+        integrand.exact = 3.14159265358979323846;
+    }
+    else if (name == "circle") {
+        integrand.dimensions = 2;
+        integrand.function = [](const double* x) { return x[0] * x[0] + x[1] * x[1] <= 1.0 ? 4.0 : 0.0; };
+        integrand.exact = 3.14159265358979323846;
+    }
+    else if (name == "gauss") {
+        // Iloczyn znormalizowanych gęstości N(0,5; w²/2) - całka po całej prostej wynosi 1
+        integrand.dimensions = max(1, dimensions);
+        integrand.function = [d = integrand.dimensions](const double* x) {
+            double exponent = 0.0;
+            for (int i = 0; i < d; ++i) {
+                double t = (x[i] - 0.5) / gaussWidth;
+                exponent += t * t;
+            }
+            return exp(-exponent) / pow(gaussWidth * sqrt(3.14159265358979323846), d);
+        };
+        integrand.exact = pow(erf(0.5 / gaussWidth), integrand.dimensions);
+    }
+    return integrand;
+}
+
+MonteCarloResult plainMonteCarlo(const Integrand& integrand, long long samples, uint64_t seed, ThreadPool& pool) {
+    vector<ChunkSums> chunks(sampleChunks);
+    pool.parallelFor(samples, sampleChunks, [&](long long begin, long long end, int chunk) {
+        vector<double> x(integrand.dimensions);
+        double sum = 0.0, sumSquares = 0.0;
+        for (long long i = begin; i < end; ++i) {
+            CounterRng rng(seed, 0, static_cast<uint64_t>(i));
+            for (double& coordinate : x) {
+                coordinate = rng.uniform();
+            }
+            double value = integrand.function(x.data());
+            sum += value;
+            sumSquares += value * value;
+        }
+        chunks[chunk].sum = sum;
+        chunks[chunk].sumSquares = sumSquares;
+    });
+
+    MonteCarloResult result;
+    combineChunks(chunks, samples, result.estimate, result.standardError);
+    result.evaluations = samples;
+    return result;
+}
+
+MonteCarloResult vegasIntegrate(const Integrand& integrand, const VegasOptions& options, ThreadPool& pool) {
+    int dimensions = integrand.dimensions;
+    int bins = max(1, options.bins);
+    long long samples = max(2LL, options.samplesPerIteration);
+    VegasGrid grid(dimensions, bins);
+
+    // Histogramy fragmentów przydzielane raz; każdy fragment pisze tylko do swojego
+    vector<ChunkSums> chunks(sampleChunks);
+    for (ChunkSums& chunk : chunks) {
+        chunk.histogram.resize(static_cast<size_t>(dimensions) * bins);
+    }
+    vector<double> histogram(static_cast<size_t>(dimensions) * bins);
+
+    MonteCarloResult result;
+    double weightedSum = 0.0, weightTotal = 0.0;
+    int totalIterations = max(0, options.warmupIterations) + max(1, options.iterations);
+    for (int iteration = 0; iteration < totalIterations; ++iteration) {
+        pool.parallelFor(samples, sampleChunks, [&](long long begin, long long end, int chunk) {
+            ChunkSums& sums = chunks[chunk];
+            fill(sums.histogram.begin(), sums.histogram.end(), 0.0);
+            vector<double> y(dimensions), x(dimensions);
+            vector<int> binIndices(dimensions);
+            double sum = 0.0, sumSquares = 0.0;
+            for (long long i = begin; i < end; ++i) {
+                CounterRng rng(options.seed, static_cast<uint32_t>(iteration + 1), static_cast<uint64_t>(i));
+                for (double& coordinate : y) {
+                    coordinate = rng.uniform();
+                }
+                double value = grid.map(y.data(), x.data(), binIndices.data()) * integrand.function(x.data());
+                double squared = value * value;
+                sum += value;
+                sumSquares += squared;
+                for (int d = 0; d < dimensions; ++d) {
+                    sums.histogram[d * bins + binIndices[d]] += squared;
+                }
+            }
+            sums.sum = sum;
+            sums.sumSquares = sumSquares;
+        });
+        result.evaluations += samples;
+
+        double mean, error;
+        combineChunks(chunks, samples, mean, error);
+        if (iteration >= options.warmupIterations) {
+            result.iterationEstimates.push_back(mean);
+            result.iterationErrors.push_back(error);
+            double weight = 1.0 / max(error * error, numeric_limits<double>::min());
+            weightedSum += weight * mean;
+            weightTotal += weight;
+        }
+
+        // Scalanie histogramów fragmentów - każdy wymiar sumowany przez osobne zadanie
+        pool.parallelFor(dimensions, dimensions, [&](long long begin, long long end, int) {
+            for (long long d = begin; d < end; ++d) {
+                double* row = &histogram[d * bins];
+                fill(row, row + bins, 0.0);
+                for (const ChunkSums& sums : chunks) {
+                    for (int i = 0; i < bins; ++i) {
+                        row[i] += sums.histogram[d * bins + i];
+                    }
+                }
+                grid.refine(static_cast<int>(d), row, options.alpha);
+            }
+        });
+    }
+
+    result.estimate = weightedSum / weightTotal;
+    result.standardError = sqrt(1.0 / weightTotal);
+    size_t count = result.iterationEstimates.size();
+    if (count > 1) {
+        double chiSquared = 0.0;
+        for (size_t i = 0; i < count; ++i) {
+            double deviation = (result.iterationEstimates[i] - result.estimate) / result.iterationErrors[i];
+            chiSquared += deviation * deviation;
+        }
+        result.chiSquaredPerDof = chiSquared / static_cast<double>(count - 1);
+    }
+    return result;
+}
+
+MonteCarloResult miserIntegrate(const Integrand& integrand, const MiserOptions& options, ThreadPool& pool) {
+    Region unit;
+    unit.lower.assign(integrand.dimensions, 0.0);
+    unit.upper.assign(integrand.dimensions, 1.0);
+    RegionEstimate estimate = miserRegion(integrand, options, pool, unit, max(2LL, options.samples));
+
+    MonteCarloResult result;
+    result.estimate = estimate.mean;
+    result.standardError = sqrt(estimate.variance);
+    result.evaluations = estimate.evaluations;
+    return result;
+}
+
+int runVegasMode(int argc, char* argv[]) {
+    string name = getOption(argc, argv, "--integrand", "gauss");
+    int dimensions = static_cast<int>(getIntOption(argc, argv, "--dims", 4));
+    int numThreads = static_cast<int>(getIntOption(argc, argv, "--threads", thread::hardware_concurrency()));
+    VegasOptions options;
+    options.samplesPerIteration = getIntOption(argc, argv, "--samples", options.samplesPerIteration);
+    options.iterations = static_cast<int>(getIntOption(argc, argv, "--iterations", options.iterations));
+    options.warmupIterations = static_cast<int>(getIntOption(argc, argv, "--warmup", options.warmupIterations));
+    options.bins = static_cast<int>(getIntOption(argc, argv, "--bins", options.bins));
+    options.alpha = getDoubleOption(argc, argv, "--alpha", options.alpha);
+    options.seed = static_cast<uint64_t>(getIntOption(argc, argv, "--seed", 1));
+
+    Integrand integrand = monteCarloIntegrand(name, dimensions);
+    if (!integrand.function) {
+        cerr << "Nieznana funkcja podcałkowa: " << name << endl;
+        return 1;
+    }
+
+    ThreadPool pool(static_cast<unsigned>(max(1, numThreads)));
+    cout << "Funkcja: " << integrand.name << ", Wymiar: " << integrand.dimensions
+        << ", Próbki na iterację: " << options.samplesPerIteration << ", Wątki: " << pool.size() << endl;
+
+    auto report = [&](const string& method, const MonteCarloResult& result, double seconds) {
+        cout << "Metoda: " << method << ", Próbki: " << result.evaluations << ", Czas: " << seconds
+            << "s, Całka: " << setprecision(12) << result.estimate << setprecision(3)
+            << ", Błąd std.: " << result.standardError
+            << ", Błąd rzeczywisty: " << fabs(result.estimate - integrand.exact) << setprecision(6);
+    };
+
+    auto startTime = chrono::high_resolution_clock::now();
+    MonteCarloResult vegas = vegasIntegrate(integrand, options, pool);
+    chrono::duration<double> duration = chrono::high_resolution_clock::now() - startTime;
+    for (size_t i = 0; i < vegas.iterationEstimates.size(); ++i) {
+        cout << "Iteracja: " << i + 1 << ", Całka: " << setprecision(12) << vegas.iterationEstimates[i]
+            << setprecision(3) << ", Błąd std.: " << vegas.iterationErrors[i] << setprecision(6) << endl;
+    }
+    report("VEGAS", vegas, duration.count());
+    cout << ", chi2/st.sw.: " << vegas.chiSquaredPerDof << endl;
+
+    // Zwykła metoda Monte Carlo z tą samą łączną liczbą próbek
+    startTime = chrono::high_resolution_clock::now();
+    MonteCarloResult plain = plainMonteCarlo(integrand, vegas.evaluations, options.seed, pool);
+    duration = chrono::high_resolution_clock::now() - startTime;
+    report("zwykłe Monte Carlo", plain, duration.count());
+    cout << endl;
+    return 0;
+}
+
+int runMiserMode(int argc, char* argv[]) {
+    string name = getOption(argc, argv, "--integrand", "gauss");
+    int dimensions = static_cast<int>(getIntOption(argc, argv, "--dims", 4));
+    string samplesList = getOption(argc, argv, "--samples", "10000,100000,1000000");
+    int numThreads = static_cast<int>(getIntOption(argc, argv, "--threads", thread::hardware_concurrency()));
+    MiserOptions options;
+    options.dither = getDoubleOption(argc, argv, "--dither", options.dither);
+    options.seed = static_cast<uint64_t>(getIntOption(argc, argv, "--seed", 1));
+
+    Integrand integrand = monteCarloIntegrand(name, dimensions);
+    if (!integrand.function) {
+        cerr << "Nieznana funkcja podcałkowa: " << name << endl;
+        return 1;
+    }
+
+    ThreadPool pool(static_cast<unsigned>(max(1, numThreads)));
+    cout << "Funkcja: " << integrand.name << ", Wymiar: " << integrand.dimensions << ", Wątki: " << pool.size() << endl;
+
+    auto report = [&](const string& method, const MonteCarloResult& result, double seconds) {
+        cout << "Próbki: " << result.evaluations << ", Metoda: " << method << ", Czas: " << seconds
+            << "s, Całka: " << setprecision(12) << result.estimate << setprecision(3)
+            << ", Błąd std.: " << result.standardError
+            << ", Błąd rzeczywisty: " << fabs(result.estimate - integrand.exact) << setprecision(6) << endl;
+    };
+
+    stringstream stream(samplesList);
+    for (string item; getline(stream, item, ',');) {
+        options.samples = static_cast<long long>(stod(item));
+
+        auto startTime = chrono::high_resolution_clock::now();
+        MonteCarloResult miser = miserIntegrate(integrand, options, pool);
+        chrono::duration<double> miserTime = chrono::high_resolution_clock::now() - startTime;
+
+        startTime = chrono::high_resolution_clock::now();
+        MonteCarloResult plain = plainMonteCarlo(integrand, miser.evaluations, options.seed, pool);
+        chrono::duration<double> plainTime = chrono::high_resolution_clock::now() - startTime;
+
+        report("MISER", miser, miserTime.count());
+        report("zwykłe Monte Carlo", plain, plainTime.count());
+        cout << "Redukcja błędu std.: " << plain.standardError / miser.standardError << "x" << endl;
+    }
+    return 0;
+}
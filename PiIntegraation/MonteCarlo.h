@@ -0,0 +1,141 @@
+﻿/**
+ * @file MonteCarlo.h
+ * @brief Całkowanie Monte Carlo na hipersześcianie jednostkowym: zwykłe, adaptacyjne (VEGAS)
+ * i z rekurencyjną stratyfikacją (MISER).
+ *
+ * Kwadratury deterministyczne (jak metoda prostokątów z PiIntegraation.cpp)
+ * tracą sens w wielu wymiarach, bo liczba węzłów rośnie wykładniczo. Błąd
+ * Monte Carlo maleje jak \( \sigma / \sqrt{N} \) niezależnie od wymiaru, a
+ * algorytm VEGAS zmniejsza wariancję \( \sigma^2 \), koncentrując próbki tam,
+ * gdzie funkcja podcałkowa ma największy udział w całce. MISER osiąga podobny
+ * efekt, dzieląc obszar na podobszary i przydzielając im próbki proporcjonalnie
+ * do lokalnej zmienności funkcji.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+class ThreadPool;
+
+/**
+ * @brief Funkcja podcałkowa określona na \( [0, 1)^d \).
+ */
+struct Integrand {
+    std::string name;                             ///< Nazwa wyświetlana w raporcie.
+    int dimensions = 1;                           ///< Wymiar d.
+    std::function<double(const double*)> function;///< Wartość w punkcie x[0..d-1].
+    double exact = 0.0;                           ///< Dokładna wartość całki (do wyznaczenia błędu).
+};
+
+/**
+ * @brief Wbudowane funkcje testowe trybu `vegas`.
+ *
+ * - `pi` – \( \frac{4}{1 + x^2} \) w jednym wymiarze (ta sama całka co w przeglądzie),
+ * - `circle` – 4 razy wskaźnik ćwiartki koła \( x^2 + y^2 \le 1 \) (dwa wymiary),
+ * - `gauss` – wąski pik Gaussa w środku hipersześcianu (dowolny wymiar).
+ *
+ * @return Funkcja testowa lub Integrand z pustym polem function dla nieznanej nazwy.
+ */
+Integrand monteCarloIntegrand(const std::string& name, int dimensions);
+
+/**
+ * @brief Wynik całkowania Monte Carlo.
+ */
+struct MonteCarloResult {
+    double estimate = 0.0;         ///< Oszacowanie całki.
+    double standardError = 0.0;    ///< Odchylenie standardowe oszacowania.
+    double chiSquaredPerDof = 0.0; ///< χ² na stopień swobody między iteracjami (tylko VEGAS).
+    long long evaluations = 0;     ///< Łączna liczba wywołań funkcji podcałkowej.
+    std::vector<double> iterationEstimates; ///< Oszacowania kolejnych iteracji (tylko VEGAS).
+    std::vector<double> iterationErrors;    ///< Ich odchylenia standardowe.
+};
+
+/**
+ * @brief Zwykła metoda Monte Carlo z \p samples próbkami jednostajnymi.
+ *
+ * Każda próbka ma własny strumień generatora licznikowego (CounterRng.h),
+ * więc wynik zależy tylko od ziarna, a nie od liczby wątków.
+ */
+MonteCarloResult plainMonteCarlo(const Integrand& integrand, long long samples, std::uint64_t seed, ThreadPool& pool);
+
+/**
+ * @brief Parametry algorytmu VEGAS.
+ */
+struct VegasOptions {
+    long long samplesPerIteration = 100000; ///< Liczba próbek w każdej iteracji.
+    int iterations = 10;                    ///< Iteracje wliczane do wyniku.
+    int warmupIterations = 3;               ///< Początkowe iteracje tylko dostosowujące siatkę.
+    int bins = 50;                          ///< Liczba przedziałów siatki w każdym wymiarze.
+    double alpha = 1.5;                     ///< Szybkość dostosowywania siatki (0 - brak zmian).
+    std::uint64_t seed = 1;                 ///< Ziarno generatora.
+};
+
+/**
+ * @brief Adaptacyjne całkowanie Monte Carlo algorytmem VEGAS (Lepage).
+ *
+ * ### Wyjaśnienie działania:
+ * - Siatka jest separowalna: w każdym wymiarze osobny podział [0, 1) na
+ *   `bins` przedziałów o równym prawdopodobieństwie, ale różnej szerokości.
+ * - Próbki dzielone są na stałą liczbę fragmentów wykonywanych przez pulę;
+ *   każdy fragment zbiera własny histogram \( f^2 \) w przedziałach siatki,
+ *   więc w trakcie iteracji wątki niczego nie współdzielą (bez blokad).
+ * - Po iteracji histogramy fragmentów są sumowane równolegle (wymiar na zadanie),
+ *   a siatka zagęszczana tam, gdzie \( f^2 \) jest największe.
+ * - Wyniki iteracji łączone są średnią ważoną odwrotnością wariancji;
+ *   χ²/st.sw. bliskie 1 oznacza, że iteracje są ze sobą zgodne.
+ */
+MonteCarloResult vegasIntegrate(const Integrand& integrand, const VegasOptions& options, ThreadPool& pool);
+
+/**
+ * @brief Parametry algorytmu MISER (wartości domyślne jak w Numerical Recipes).
+ */
+struct MiserOptions {
+    long long samples = 1000000;      ///< Łączna liczba wywołań funkcji podcałkowej.
+    double explorationFraction = 0.1; ///< Część próbek obszaru zużywana na wybór podziału.
+    long long minPoints = 15;         ///< Najmniejsza liczba próbek rozpoznania i podobszaru.
+    long long minBisect = 60;         ///< Poniżej tej liczby próbek obszar nie jest dzielony.
+    double dither = 0.05;             ///< Losowe przesunięcie punktu podziału (ułamek szerokości).
+    std::uint64_t seed = 1;           ///< Ziarno generatora.
+};
+
+/**
+ * @brief Całkowanie Monte Carlo z rekurencyjną stratyfikacją (MISER, Press i Farrar).
+ *
+ * ### Wyjaśnienie działania:
+ * - Część próbek obszaru służy do rozpoznania: dla każdego wymiaru zbierany
+ *   jest zakres wartości funkcji po obu stronach środka obszaru.
+ * - Obszar dzielony jest na pół w wymiarze, w którym suma
+ *   \( \sigma_l^{2/3} + \sigma_r^{2/3} \) jest najmniejsza, a pozostałe próbki
+ *   przydzielane połówkom proporcjonalnie do ich zmienności.
+ * - Połówki z dużą liczbą próbek są liczone równolegle jako zadania puli
+ *   (zagnieżdżone parallelFor), małe obszary zwykłą metodą Monte Carlo.
+ * - Każdy obszar ma własny klucz generatora licznikowego wyznaczony z numeru
+ *   obszaru w drzewie podziałów, więc wynik nie zależy od liczby wątków.
+ */
+MonteCarloResult miserIntegrate(const Integrand& integrand, const MiserOptions& options, ThreadPool& pool);
+
+/**
+ * @brief Uruchamia tryb `vegas`.
+ *
+ * Opcje: `--integrand pi|circle|gauss`, `--dims d`, `--samples n` (na iterację),
+ * `--iterations n`, `--warmup n`, `--bins n`, `--alpha x`, `--seed n`, `--threads n`.
+ * Wynik porównywany jest ze zwykłą metodą Monte Carlo o tej samej łącznej liczbie próbek.
+ *
+ * @return Kod zakończenia programu.
+ */
+int runVegasMode(int argc, char* argv[]);
+
+/**
+ * @brief Uruchamia tryb `miser` - porównanie MISER i zwykłej metody Monte Carlo.
+ *
+ * Opcje: `--integrand pi|circle|gauss`, `--dims d`, `--samples n[,n...]`
+ * (lista łącznych liczb próbek), `--dither x`, `--seed n`, `--threads n`.
+ * Dla każdej liczby próbek obie metody dostają ten sam budżet wywołań funkcji.
+ *
+ * @return Kod zakończenia programu.
+ */
+int runMiserMode(int argc, char* argv[]);
@@ -0,0 +1,116 @@
+﻿/**
+ * @file MpmcQueue.h
+ * @brief Ograniczona kolejka bez blokad dla wielu producentów i wielu konsumentów.
+ *
+ * Bufor cykliczny Vyukova: każde miejsce ma własny numer sekwencyjny, który
+ * mówi, czy miejsce jest wolne dla producenta pozycji pos (sequence == pos),
+ * czy zawiera element dla konsumenta (sequence == pos + 1). Producenci
+ * i konsumenci rezerwują pozycje jedną operacją compare-exchange na osobnych
+ * licznikach, więc nie ma blokady, a jedynym punktem rywalizacji jest licznik
+ * po "swojej" stronie kolejki. W odróżnieniu od SpscQueue dopuszcza dowolną
+ * liczbę wątków po obu stronach.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+/**
+ * @brief Kolejka FIFO o stałej pojemności (potęga dwójki) dla wielu wątków.
+ * @tparam T Typ elementów (przenoszonych, z konstruktorem domyślnym).
+ */
+template <typename T>
+class MpmcQueue {
+public:
+    /// Tworzy kolejkę mieszczącą co najmniej \p capacity elementów.
+    explicit MpmcQueue(std::size_t capacity) {
+        std::size_t size = 2;
+        while (size < capacity) {
+            size *= 2;
+        }
+        cells = std::make_unique<Cell[]>(size);
+        mask = size - 1;
+        for (std::size_t i = 0; i < size; ++i) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpmcQueue(const MpmcQueue&) = delete;
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+    /**
+     * @brief Wstawia element bez czekania.
+     * @return false, jeśli kolejka jest pełna (element \p item pozostaje nienaruszony).
+     */
+    bool tryPush(T&& item) {
+        Cell* cell;
+        std::size_t position = enqueuePosition.load(std::memory_order_relaxed);
+        for (;;) {
+            cell = &cells[position & mask];
+            std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            std::intptr_t difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+            if (difference == 0) {
+                if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            }
+            else if (difference < 0) {
+                return false;
+            }
+            else {
+                position = enqueuePosition.load(std::memory_order_relaxed);
+            }
+        }
+        cell->value = std::move(item);
+        cell->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Pobiera element bez czekania.
+     * @return false, jeśli kolejka jest pusta.
+     */
+    bool tryPop(T& item) {
+        Cell* cell;
+        std::size_t position = dequeuePosition.load(std::memory_order_relaxed);
+        for (;;) {
+            cell = &cells[position & mask];
+            std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            std::intptr_t difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position + 1);
+            if (difference == 0) {
+                if (dequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            }
+            else if (difference < 0) {
+                return false;
+            }
+            else {
+                position = dequeuePosition.load(std::memory_order_relaxed);
+            }
+        }
+        item = std::move(cell->value);
+        cell->value = T();
+        cell->sequence.store(position + mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Pojemność kolejki.
+    std::size_t capacity() const { return mask + 1; }
+
+private:
+    /// Miejsce w buforze - w osobnej linii pamięci podręcznej.
+    struct alignas(64) Cell {
+        std::atomic<std::size_t> sequence{ 0 };
+        T value{};
+    };
+
+    std::unique_ptr<Cell[]> cells;
+    std::size_t mask = 0;
+    alignas(64) std::atomic<std::size_t> enqueuePosition{ 0 };
+    alignas(64) std::atomic<std::size_t> dequeuePosition{ 0 };
+};
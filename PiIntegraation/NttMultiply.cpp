@@ -0,0 +1,281 @@
+﻿/**
+ * @file NttMultiply.cpp
+ * @brief Implementacja mnożenia NTT: arytmetyka Montgomery'ego (skalarna i AVX2), transformaty i CRT.
+ */
+
+#include "NttMultiply.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define PI_NTT_AVX2 1
+#endif
+
+using namespace std;
+
+namespace {
+
+/**
+ * @brief Moduł NTT wraz ze stałymi arytmetyki Montgomery'ego (R = 2^32).
+ */
+struct Modulus {
+    uint32_t p;       ///< Liczba pierwsza c·2^k + 1 mniejsza od 2^30.
+    uint32_t inverse; ///< p^(−1) mod 2^32.
+    uint32_t r2;      ///< R² mod p, do konwersji do postaci Montgomery'ego.
+    uint32_t root;    ///< Pierwiastek pierwotny modulo p.
+
+    Modulus(uint32_t p, uint32_t root) : p(p), root(root) {
+        inverse = p;
+        for (int i = 0; i < 5; ++i) {
+            inverse *= 2 - p * inverse; // Newton: każda iteracja podwaja liczbę poprawnych bitów
+        }
+        uint64_t r = (uint64_t(1) << 32) % p;
+        r2 = static_cast<uint32_t>(r * r % p);
+    }
+
+    /// a·b·R^(−1) mod p; wynik w [0, p).
+    uint32_t multiply(uint32_t a, uint32_t b) const {
+        uint64_t product = static_cast<uint64_t>(a) * b;
+        uint32_t q = static_cast<uint32_t>(product) * inverse;
+        // Młodsze słowa product i q·p są równe, więc różnica starszych słów jest dokładna
+        int64_t t = static_cast<int64_t>(product >> 32) - static_cast<int64_t>((static_cast<uint64_t>(q) * p) >> 32);
+        return static_cast<uint32_t>(t < 0 ? t + p : t);
+    }
+
+    uint32_t add(uint32_t a, uint32_t b) const {
+        uint32_t sum = a + b;
+        return sum >= p ? sum - p : sum;
+    }
+
+    uint32_t subtract(uint32_t a, uint32_t b) const {
+        return a >= b ? a - b : a + p - b;
+    }
+
+    uint32_t toMontgomery(uint32_t a) const { return multiply(a, r2); }
+    uint32_t fromMontgomery(uint32_t a) const { return multiply(a, 1); }
+
+    /// a^e mod p w zwykłej (nie Montgomery'ego) reprezentacji.
+    uint32_t power(uint64_t a, uint64_t e) const {
+        uint64_t result = 1;
+        a %= p;
+        for (; e != 0; e >>= 1) {
+            if (e & 1) {
+                result = result * a % p;
+            }
+            a = a * a % p;
+        }
+        return static_cast<uint32_t>(result);
+    }
+};
+
+const Modulus moduli[3] = {
+    Modulus(998244353, 3), // 119·2^23 + 1
+    Modulus(167772161, 3), // 5·2^25 + 1
+    Modulus(469762049, 3), // 7·2^26 + 1
+};
+
+/// Od tego rozmiaru transformaty etapy motylków są dzielone między wątki.
+constexpr size_t parallelTransformSize = size_t(1) << 15;
+
+#if defined(PI_NTT_AVX2)
+
+/// Mnożenie Montgomery'ego 8 liczb jednocześnie (linie parzyste i nieparzyste osobno przez _mm256_mul_epu32).
+inline __m256i multiply8(__m256i a, __m256i b, __m256i p, __m256i inverse) {
+    __m256i productEven = _mm256_mul_epu32(a, b);
+    __m256i productOdd = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32));
+    __m256i qpEven = _mm256_mul_epu32(_mm256_mul_epu32(productEven, inverse), p);
+    __m256i qpOdd = _mm256_mul_epu32(_mm256_mul_epu32(productOdd, inverse), p);
+    __m256i productHigh = _mm256_blend_epi32(_mm256_srli_epi64(productEven, 32), productOdd, 0xAA);
+    __m256i qpHigh = _mm256_blend_epi32(_mm256_srli_epi64(qpEven, 32), qpOdd, 0xAA);
+    __m256i t = _mm256_sub_epi32(productHigh, qpHigh);
+    return _mm256_add_epi32(t, _mm256_and_si256(p, _mm256_cmpgt_epi32(_mm256_setzero_si256(), t)));
+}
+
+inline __m256i add8(__m256i a, __m256i b, __m256i p) {
+    __m256i sum = _mm256_add_epi32(a, b);
+    return _mm256_min_epu32(sum, _mm256_sub_epi32(sum, p));
+}
+
+inline __m256i subtract8(__m256i a, __m256i b, __m256i p) {
+    __m256i difference = _mm256_add_epi32(_mm256_sub_epi32(a, b), p);
+    return _mm256_min_epu32(difference, _mm256_sub_epi32(difference, p));
+}
+
+#endif
+
+/**
+ * @brief Transformata NTT jednego wektora modulo jedna liczba pierwsza.
+ */
+class Transform {
+public:
+    Transform(const Modulus& modulus, size_t size) : modulus(modulus), size(size), roots(size), inverseRoots(size) {
+        // roots[len + j] = ω_{2·len}^j w postaci Montgomery'ego
+        uint32_t inverseRoot = modulus.power(modulus.root, modulus.p - 2);
+        for (size_t length = 1; length < size; length <<= 1) {
+            uint32_t step = modulus.toMontgomery(modulus.power(modulus.root, (modulus.p - 1) / (2 * length)));
+            uint32_t inverseStep = modulus.toMontgomery(modulus.power(inverseRoot, (modulus.p - 1) / (2 * length)));
+            uint32_t w = modulus.toMontgomery(1), inverseW = w;
+            for (size_t j = 0; j < length; ++j) {
+                roots[length + j] = w;
+                inverseRoots[length + j] = inverseW;
+                w = modulus.multiply(w, step);
+                inverseW = modulus.multiply(inverseW, inverseStep);
+            }
+        }
+    }
+
+    /// Transformata w przód (decymacja w częstotliwości) - wynik w porządku odwróconych bitów.
+    void forward(uint32_t* data, ThreadPool* pool) const {
+        for (size_t length = size / 2; length >= 1; length >>= 1) {
+            runStage(data, length, false, pool);
+        }
+    }
+
+    /// Transformata odwrotna (decymacja w czasie) z wejścia w porządku odwróconych bitów, bez dzielenia przez n.
+    void inverse(uint32_t* data, ThreadPool* pool) const {
+        for (size_t length = 1; length < size; length <<= 1) {
+            runStage(data, length, true, pool);
+        }
+    }
+
+private:
+    void runStage(uint32_t* data, size_t length, bool inverseStage, ThreadPool* pool) const {
+        long long butterflies = static_cast<long long>(size / 2);
+        if (pool == nullptr || size < parallelTransformSize) {
+            butterflyRange(data, length, inverseStage, 0, butterflies);
+            return;
+        }
+        pool->parallelFor(butterflies, static_cast<int>(pool->size()) * 4, [&](long long begin, long long end, int) {
+            butterflyRange(data, length, inverseStage, begin, end);
+        });
+    }
+
+    /// Motylki o numerach [begin, end) etapu o długości połówki bloku \p length.
+    void butterflyRange(uint32_t* data, size_t length, bool inverseStage, long long begin, long long end) const {
+        const uint32_t* twiddles = (inverseStage ? inverseRoots.data() : roots.data()) + length;
+        while (begin < end) {
+            size_t block = static_cast<size_t>(begin) / length;
+            size_t j = static_cast<size_t>(begin) % length;
+            size_t last = min(length, j + static_cast<size_t>(end - begin));
+            uint32_t* low = data + block * 2 * length;
+            uint32_t* high = low + length;
+            begin += static_cast<long long>(last - j);
+#if defined(PI_NTT_AVX2)
+            __m256i p = _mm256_set1_epi32(static_cast<int>(modulus.p));
+            __m256i inverse = _mm256_set1_epi32(static_cast<int>(modulus.inverse));
+            for (; j + 8 <= last; j += 8) {
+                __m256i u = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(low + j));
+                __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(high + j));
+                __m256i w = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(twiddles + j));
+                if (inverseStage) {
+                    v = multiply8(v, w, p, inverse);
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(low + j), add8(u, v, p));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(high + j), subtract8(u, v, p));
+                }
+                else {
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(low + j), add8(u, v, p));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(high + j), multiply8(subtract8(u, v, p), w, p, inverse));
+                }
+            }
+#endif
+            for (; j < last; ++j) {
+                uint32_t u = low[j];
+                uint32_t v = high[j];
+                if (inverseStage) {
+                    v = modulus.multiply(v, twiddles[j]);
+                    low[j] = modulus.add(u, v);
+                    high[j] = modulus.subtract(u, v);
+                }
+                else {
+                    low[j] = modulus.add(u, v);
+                    high[j] = modulus.multiply(modulus.subtract(u, v), twiddles[j]);
+                }
+            }
+        }
+    }
+
+    const Modulus& modulus;
+    size_t size;
+    vector<uint32_t> roots;
+    vector<uint32_t> inverseRoots;
+};
+
+/// Splot a * b modulo jedna liczba pierwsza; wynik w zwykłej reprezentacji.
+vector<uint32_t> convolution(const Modulus& modulus, const Limbs& a, const Limbs& b, size_t size, ThreadPool* pool) {
+    Transform transform(modulus, size);
+    vector<uint32_t> fa(size, 0), fb(size, 0);
+    for (size_t i = 0; i < a.size(); ++i) {
+        fa[i] = modulus.toMontgomery(a[i] % modulus.p);
+    }
+    for (size_t i = 0; i < b.size(); ++i) {
+        fb[i] = modulus.toMontgomery(b[i] % modulus.p);
+    }
+    transform.forward(fa.data(), pool);
+    transform.forward(fb.data(), pool);
+    for (size_t i = 0; i < size; ++i) {
+        fa[i] = modulus.multiply(fa[i], fb[i]);
+    }
+    transform.inverse(fa.data(), pool);
+
+    // Dzielenie przez n i powrót z postaci Montgomery'ego jednym mnożeniem
+    uint32_t scale = modulus.power(size, modulus.p - 2);
+    for (size_t i = 0; i < size; ++i) {
+        fa[i] = modulus.multiply(fa[i], scale);
+    }
+    return fa;
+}
+
+} // namespace
+
+Limbs nttMultiply(const Limbs& a, const Limbs& b, ThreadPool* pool) {
+    if (a.empty() || b.empty()) {
+        return Limbs();
+    }
+    size_t resultSize = a.size() + b.size();
+    size_t size = 1;
+    while (size < resultSize - 1) {
+        size <<= 1;
+    }
+
+    // Trzy niezależne sploty - równolegle, każdy dodatkowo z równoległymi etapami
+    vector<uint32_t> residues[3];
+    auto compute = [&](int index) { residues[index] = convolution(moduli[index], a, b, size, pool); };
+    if (pool != nullptr) {
+        pool->parallelFor(3, 3, [&](long long begin, long long, int) { compute(static_cast<int>(begin)); });
+    }
+    else {
+        for (int i = 0; i < 3; ++i) {
+            compute(i);
+        }
+    }
+
+    // Algorytm Garnera: X = r1 + p1·k2 + p1·p2·k3 < p1·p2·p3 ≈ 7.9·10^25
+    const uint64_t p1 = moduli[0].p, p2 = moduli[1].p, p3 = moduli[2].p;
+    const uint64_t inverseP1 = moduli[1].power(p1, p2 - 2);
+    const uint64_t p12 = p1 * p2;
+    const uint64_t inverseP12 = moduli[2].power(p12 % p3, p3 - 2);
+    const uint64_t p12Low = p12 % limbBase, p12High = p12 / limbBase;
+
+    Limbs result(resultSize, 0);
+    uint64_t carry = 0;
+    for (size_t i = 0; i < resultSize; ++i) {
+        uint64_t x12 = 0, k3 = 0;
+        if (i < size) {
+            uint64_t r1 = residues[0][i], r2 = residues[1][i], r3 = residues[2][i];
+            uint64_t k2 = (r2 + p2 - r1 % p2) % p2 * inverseP1 % p2;
+            x12 = r1 + p1 * k2;
+            k3 = (r3 + p3 - x12 % p3) % p3 * inverseP12 % p3;
+        }
+        // X = x12 + p12·k3 rozpisane na cyfry o podstawie 10^9 (bez arytmetyki 128-bitowej)
+        uint64_t low = p12Low * k3 + x12 % limbBase + carry % limbBase;
+        uint64_t middle = p12High * k3 + x12 / limbBase + low / limbBase;
+        result[i] = static_cast<uint32_t>(low % limbBase);
+        carry = middle + carry / limbBase;
+    }
+    trimLimbs(result);
+    return result;
+}
@@ -0,0 +1,28 @@
+﻿/**
+ * @file NttMultiply.h
+ * @brief Mnożenie dużych liczb transformatą teorioliczbową (NTT) modulo trzy liczby pierwsze.
+ *
+ * Splot limbów o podstawie 10^9 liczony jest niezależnie modulo trzy liczby
+ * pierwsze postaci c·2^k + 1, a wynik odtwarzany jest z chińskiego twierdzenia
+ * o resztach (algorytm Garnera). Mnożenia modularne wykonywane są w arytmetyce
+ * Montgomery'ego - wektorowo (AVX2, 8 linii), jeśli kompilator na to pozwala.
+ * Etapy motylków są dzielone między wątki puli.
+ */
+
+#pragma once
+
+#include "BigNumber.h"
+
+class ThreadPool;
+
+/// Największa liczba limbów iloczynu obsługiwana przez NTT (ograniczenie modułu 998244353 = 119·2^23 + 1).
+constexpr std::size_t maxNttProductLimbs = std::size_t(1) << 23;
+
+/**
+ * @brief Iloczyn dwóch liczb naturalnych przez trzy transformaty NTT i CRT.
+ *
+ * @param a Pierwszy czynnik.
+ * @param b Drugi czynnik (a.size() + b.size() nie może przekraczać maxNttProductLimbs).
+ * @param pool Pula wątków dla równoległych etapów transformaty lub nullptr.
+ */
+Limbs nttMultiply(const Limbs& a, const Limbs& b, ThreadPool* pool);
@@ -0,0 +1,319 @@
+﻿/**
+ * @file OscillatoryIntegral.cpp
+ * @brief Implementacja metod prostokątów, Filona i Levina dla całek oscylujących.
+ */
+
+#include "OscillatoryIntegral.h"
+#include "CommandLine.h"
+#include "Integration.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+constexpr double pi = 3.14159265358979323846;
+
+/// Poniżej tej wartości ωh wagi Filona liczone są z rozwinięcia w szereg (unika utraty cyfr).
+constexpr double filonSeriesLimit = 0.1;
+
+/// Poniżej tej wartości ωh układ Levina jest źle uwarunkowany - panel liczony jest kwadraturą Gaussa.
+constexpr double levinMinimumPhase = 1.0;
+
+double oscillator(const OscillatoryIntegral& integral, double x) {
+    return integral.oscillator == Oscillator::Sine ? sin(integral.omega * x) : cos(integral.omega * x);
+}
+
+/**
+ * @brief Wagi α, β, γ metody Filona dla θ = ωh.
+ */
+void filonWeights(double theta, double& alpha, double& beta, double& gamma) {
+    if (fabs(theta) < filonSeriesLimit) {
+        double t2 = theta * theta, t3 = t2 * theta;
+        alpha = t3 * (2.0 / 45.0 - t2 * (2.0 / 315.0 - t2 * (2.0 / 4725.0)));
+        beta = 2.0 / 3.0 + t2 * (2.0 / 15.0 - t2 * (4.0 / 105.0 - t2 * (2.0 / 567.0)));
+        gamma = 4.0 / 3.0 - t2 * (2.0 / 15.0 - t2 * (1.0 / 210.0 - t2 * (1.0 / 11340.0)));
+        return;
+    }
+    double s = sin(theta), c = cos(theta), t3 = theta * theta * theta;
+    alpha = (theta * theta + theta * s * c - 2.0 * s * s) / t3;
+    beta = 2.0 * (theta * (1.0 + c * c) - 2.0 * s * c) / t3;
+    gamma = 4.0 * (s - theta * c) / t3;
+}
+
+/**
+ * @brief Filon-Simpson na panelu [a, a + 2h]: amplituda przybliżana parabolą przez trzy węzły.
+ */
+double filonPanel(const OscillatoryIntegral& integral, double a, double h) {
+    double x[3] = { a, a + h, a + 2.0 * h };
+    double g[3];
+    for (int i = 0; i < 3; ++i) {
+        g[i] = integral.amplitude(x[i]);
+    }
+    double alpha, beta, gamma;
+    filonWeights(integral.omega * h, alpha, beta, gamma);
+    double w = integral.omega;
+    if (integral.oscillator == Oscillator::Cosine) {
+        return h * (alpha * (g[2] * sin(w * x[2]) - g[0] * sin(w * x[0]))
+            + beta * 0.5 * (g[0] * cos(w * x[0]) + g[2] * cos(w * x[2]))
+            + gamma * g[1] * cos(w * x[1]));
+    }
+    return h * (-alpha * (g[2] * cos(w * x[2]) - g[0] * cos(w * x[0]))
+        + beta * 0.5 * (g[0] * sin(w * x[0]) + g[2] * sin(w * x[2]))
+        + gamma * g[1] * sin(w * x[1]));
+}
+
+/**
+ * @brief Węzły i wagi kwadratury Gaussa-Legendre'a na [−1, 1] (metoda Newtona).
+ */
+void gaussLegendre(int n, vector<double>& nodes, vector<double>& weights) {
+    nodes.resize(n);
+    weights.resize(n);
+    for (int i = 0; i < n; ++i) {
+        double t = cos(pi * (i + 0.75) / (n + 0.5));
+        double derivative = 1.0;
+        for (int iteration = 0; iteration < 100; ++iteration) {
+            double p0 = 1.0, p1 = t;
+            for (int k = 2; k <= n; ++k) {
+                double p2 = ((2.0 * k - 1.0) * t * p1 - (k - 1.0) * p0) / k;
+                p0 = p1;
+                p1 = p2;
+            }
+            derivative = n * (t * p1 - p0) / (t * t - 1.0);
+            double step = p1 / derivative;
+            t -= step;
+            if (fabs(step) < 1e-16) {
+                break;
+            }
+        }
+        nodes[i] = t;
+        weights[i] = 2.0 / ((1.0 - t * t) * derivative * derivative);
+    }
+}
+
+/**
+ * @brief Kolokacja Levina na jednym panelu.
+ *
+ * Szukany jest wielomian p (w bazie Czebyszewa) spełniający w węzłach
+ * Czebyszewa-Lobatto równanie \( p'(x) + i\omega p(x) = g(x) \). Wtedy
+ * \( \int_a^b g(x) e^{i\omega x} dx = p(b) e^{i\omega b} - p(a) e^{i\omega a} \).
+ * Pamięć na układ równań przekazywana jest z zewnątrz, aby nie alokować jej na każdy panel.
+ */
+class LevinPanel {
+public:
+    LevinPanel() : matrix(levinPoints * levinPoints), rhs(levinPoints) {
+        gaussLegendre(levinPoints, gaussNodes, gaussWeights);
+    }
+
+    double integrate(const OscillatoryIntegral& integral, double a, double b) {
+        double center = 0.5 * (a + b), half = 0.5 * (b - a);
+        double w = integral.omega;
+        if (fabs(w * half) < levinMinimumPhase) {
+            // Mniej niż ok. 1/3 okresu na panel - funkcja jest gładka, wystarcza kwadratura Gaussa
+            double sum = 0.0;
+            for (int j = 0; j < levinPoints; ++j) {
+                double x = center + half * gaussNodes[j];
+                sum += gaussWeights[j] * integral.amplitude(x) * oscillator(integral, x);
+            }
+            return half * sum;
+        }
+
+        const int n = levinPoints;
+        const complex<double> iw(0.0, w);
+        for (int j = 0; j < n; ++j) {
+            double t = cos(pi * j / (n - 1));
+            rhs[j] = integral.amplitude(center + half * t);
+            // T_k(t) i pochodne T_k'(t) = k U_{k-1}(t) z rekurencji
+            double tPrevious = 1.0, tCurrent = t;
+            double uPrevious = 0.0, uCurrent = 1.0;
+            for (int k = 0; k < n; ++k) {
+                double value, derivative;
+                if (k == 0) {
+                    value = 1.0;
+                    derivative = 0.0;
+                }
+                else {
+                    value = tCurrent;
+                    derivative = k * uCurrent;
+                    double tNext = 2.0 * t * tCurrent - tPrevious;
+                    double uNext = 2.0 * t * uCurrent - uPrevious;
+                    tPrevious = tCurrent;
+                    tCurrent = tNext;
+                    uPrevious = uCurrent;
+                    uCurrent = uNext;
+                }
+                matrix[j * n + k] = derivative / half + iw * value;
+            }
+        }
+        solve();
+
+        complex<double> atUpper = 0.0, atLower = 0.0;
+        for (int k = 0; k < n; ++k) {
+            atUpper += rhs[k];
+            atLower += k % 2 == 0 ? rhs[k] : -rhs[k];
+        }
+        complex<double> result = atUpper * polar(1.0, w * b) - atLower * polar(1.0, w * a);
+        return integral.oscillator == Oscillator::Sine ? result.imag() : result.real();
+    }
+
+private:
+    /// Eliminacja Gaussa z częściowym wyborem elementu głównego; rozwiązanie trafia do rhs.
+    void solve() {
+        const int n = levinPoints;
+        for (int column = 0; column < n; ++column) {
+            int pivot = column;
+            for (int row = column + 1; row < n; ++row) {
+                if (abs(matrix[row * n + column]) > abs(matrix[pivot * n + column])) {
+                    pivot = row;
+                }
+            }
+            if (pivot != column) {
+                swap_ranges(matrix.begin() + pivot * n, matrix.begin() + pivot * n + n, matrix.begin() + column * n);
+                swap(rhs[pivot], rhs[column]);
+            }
+            for (int row = column + 1; row < n; ++row) {
+                complex<double> factor = matrix[row * n + column] / matrix[column * n + column];
+                for (int k = column; k < n; ++k) {
+                    matrix[row * n + k] -= factor * matrix[column * n + k];
+                }
+                rhs[row] -= factor * rhs[column];
+            }
+        }
+        for (int row = n - 1; row >= 0; --row) {
+            for (int k = row + 1; k < n; ++k) {
+                rhs[row] -= matrix[row * n + k] * rhs[k];
+            }
+            rhs[row] /= matrix[row * n + row];
+        }
+    }
+
+    vector<complex<double>> matrix;
+    vector<complex<double>> rhs;
+    vector<double> gaussNodes;
+    vector<double> gaussWeights;
+};
+
+} // namespace
+
+double integrateOscillatory(const OscillatoryIntegral& integral, OscillatoryMethod method, long long panels, ThreadPool& pool) {
+    panels = max(1LL, panels);
+    double width = (integral.upper - integral.lower) / static_cast<double>(panels);
+    int chunks = static_cast<int>(min<long long>(panels, pool.size() * 8));
+    vector<double> partial(chunks, 0.0);
+
+    pool.parallelFor(panels, chunks, [&](long long begin, long long end, int chunk) {
+        double sum = 0.0;
+        if (method == OscillatoryMethod::Levin) {
+            LevinPanel levin;
+            for (long long i = begin; i < end; ++i) {
+                double a = integral.lower + i * width;
+                sum += levin.integrate(integral, a, a + width);
+            }
+        }
+        else if (method == OscillatoryMethod::Filon) {
+            for (long long i = begin; i < end; ++i) {
+                sum += filonPanel(integral, integral.lower + i * width, 0.5 * width);
+            }
+        }
+        else {
+            for (long long i = begin; i < end; ++i) {
+                double x = integral.lower + (i + 0.5) * width;
+                sum += integral.amplitude(x) * oscillator(integral, x) * width;
+            }
+        }
+        partial[chunk] = sum;
+    });
+
+    double total = 0.0;
+    for (double value : partial) {
+        total += value;
+    }
+    return total;
+}
+
+long long oscillatoryEvaluations(OscillatoryMethod method, long long panels) {
+    switch (method) {
+    case OscillatoryMethod::Filon:
+        return 3 * panels;
+    case OscillatoryMethod::Levin:
+        return levinPoints * panels;
+    default:
+        return panels;
+    }
+}
+
+int runOscillatoryMode(int argc, char* argv[]) {
+    string amplitudeName = getOption(argc, argv, "--amplitude", "pi");
+    string oscillatorName = getOption(argc, argv, "--oscillator", "sin");
+    string omegaList = getOption(argc, argv, "--omega", "10,1000,100000,10000000");
+    long long panels = max(1LL, getIntOption(argc, argv, "--panels", 64));
+    int numThreads = static_cast<int>(getIntOption(argc, argv, "--threads", thread::hardware_concurrency()));
+
+    OscillatoryIntegral integral;
+    if (amplitudeName == "pi") {
+        integral.amplitude = f;
+    }
+    else if (amplitudeName == "exp") {
+        integral.amplitude = [](double x) { return exp(x); };
+    }
+    else {
+        cerr << "Nieznana amplituda: " << amplitudeName << endl;
+        return 1;
+    }
+    if (oscillatorName != "sin" && oscillatorName != "cos") {
+        cerr << "Nieznany czynnik oscylujący: " << oscillatorName << endl;
+        return 1;
+    }
+    integral.oscillator = oscillatorName == "sin" ? Oscillator::Sine : Oscillator::Cosine;
+
+    ThreadPool pool(static_cast<unsigned>(max(1, numThreads)));
+    cout << "Amplituda: " << amplitudeName << ", Oscylator: " << oscillatorName << ", Panele: " << panels
+        << ", Wątki: " << pool.size() << endl;
+
+    stringstream stream(omegaList);
+    for (string item; getline(stream, item, ',');) {
+        integral.omega = stod(item);
+
+        // Wartość odniesienia: wzór zamknięty dla eˣ, w pozostałych przypadkach Levin na gęstym podziale
+        double reference;
+        if (amplitudeName == "exp") {
+            complex<double> exponent(1.0, integral.omega);
+            complex<double> exact = (exp(exponent) - 1.0) / exponent;
+            reference = integral.oscillator == Oscillator::Sine ? exact.imag() : exact.real();
+        }
+        else {
+            reference = integrateOscillatory(integral, OscillatoryMethod::Levin, 1024, pool);
+        }
+
+        struct Run {
+            const char* name;
+            OscillatoryMethod method;
+            long long panels;
+        };
+        const Run runs[] = {
+            { "prostokąty", OscillatoryMethod::Midpoint, panels },
+            { "prostokąty (budżet Levina)", OscillatoryMethod::Midpoint, oscillatoryEvaluations(OscillatoryMethod::Levin, panels) },
+            { "Filon", OscillatoryMethod::Filon, panels },
+            { "Levin", OscillatoryMethod::Levin, panels },
+        };
+        for (const Run& run : runs) {
+            auto startTime = chrono::high_resolution_clock::now();
+            double value = integrateOscillatory(integral, run.method, run.panels, pool);
+            chrono::duration<double> duration = chrono::high_resolution_clock::now() - startTime;
+            cout << "Omega: " << integral.omega << ", Metoda: " << run.name
+                << ", Wywołania: " << oscillatoryEvaluations(run.method, run.panels)
+                << ", Czas: " << duration.count() << "s, Całka: " << setprecision(15) << value
+                << ", Błąd: " << setprecision(3) << fabs(value - reference) << setprecision(6) << endl;
+        }
+    }
+    return 0;
+}
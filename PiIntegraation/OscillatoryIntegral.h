@@ -0,0 +1,71 @@
+﻿/**
+ * @file OscillatoryIntegral.h
+ * @brief Całki funkcji szybko oscylujących \( \int_a^b g(x) \sin(\omega x)\,dx \) i \( \int_a^b g(x) \cos(\omega x)\,dx \).
+ *
+ * Metoda prostokątów z calculatePartialIntegral() potrzebuje kilku węzłów na
+ * każdy okres oscylacji, więc jej koszt rośnie liniowo z \( \omega \).
+ * Metody Filona i Levina przybliżają tylko gładką amplitudę \( g \), a czynnik
+ * oscylujący całkują dokładnie - ich koszt nie zależy od \( \omega \).
+ */
+
+#pragma once
+
+#include <functional>
+
+class ThreadPool;
+
+/// Czynnik oscylujący funkcji podcałkowej.
+enum class Oscillator {
+    Sine,   ///< \( \sin(\omega x) \)
+    Cosine, ///< \( \cos(\omega x) \)
+};
+
+/// Metody całkowania funkcji oscylujących.
+enum class OscillatoryMethod {
+    Midpoint, ///< Metoda prostokątów (punkt odniesienia), jeden węzeł na panel.
+    Filon,    ///< Filon-Simpson: amplituda przybliżana parabolą, trzy węzły na panel.
+    Levin,    ///< Kolokacja Levina: levinPoints węzłów Czebyszewa na panel.
+};
+
+/// Liczba węzłów kolokacji Levina na panel.
+constexpr int levinPoints = 12;
+
+/**
+ * @brief Opis całki \( \int_{lower}^{upper} g(x) \cdot osc(\omega x)\,dx \).
+ */
+struct OscillatoryIntegral {
+    std::function<double(double)> amplitude;   ///< Gładka amplituda g(x).
+    double omega = 1.0;                        ///< Częstość ω.
+    Oscillator oscillator = Oscillator::Sine;  ///< sin lub cos.
+    double lower = 0.0;                        ///< Dolna granica całkowania.
+    double upper = 1.0;                        ///< Górna granica całkowania.
+};
+
+/**
+ * @brief Wspólne wejście dla wszystkich metod: całka podzielona na \p panels równych paneli.
+ *
+ * Panele są niezależne, więc dzielone są na fragmenty wykonywane przez pulę wątków,
+ * a wyniki fragmentów sumowane na końcu (jak w przeglądzie wydajności).
+ *
+ * @param integral Całka do obliczenia.
+ * @param method Metoda całkowania.
+ * @param panels Liczba paneli (co najmniej 1).
+ * @param pool Pula wątków.
+ * @return Przybliżona wartość całki.
+ */
+double integrateOscillatory(const OscillatoryIntegral& integral, OscillatoryMethod method, long long panels, ThreadPool& pool);
+
+/// Liczba wywołań amplitudy potrzebna metodzie \p method dla \p panels paneli.
+long long oscillatoryEvaluations(OscillatoryMethod method, long long panels);
+
+/**
+ * @brief Uruchamia tryb `oscillatory`.
+ *
+ * Opcje: `--amplitude pi|exp` (g(x) = 4/(1+x²) lub eˣ na [0, 1]), `--oscillator sin|cos`,
+ * `--omega x[,x...]`, `--panels n`, `--threads n`. Dla każdej częstości wszystkie
+ * metody porównywane są przy tej samej liczbie paneli, a metoda prostokątów
+ * dodatkowo przy tej samej liczbie wywołań amplitudy co metoda Levina.
+ *
+ * @return Kod zakończenia programu.
+ */
+int runOscillatoryMode(int argc, char* argv[]);
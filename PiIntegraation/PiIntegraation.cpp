@@ -9,12 +9,38 @@
  * dla różnych konfiguracji liczby wątków i kroków.
  */
 
+#include <algorithm>
+#include <atomic>
 #include <iostream>
 #include <thread>
 #include <vector>
 #include <chrono>
 #include <cmath>
 #include <fstream>
+#include <string>
+
+#include "AgmPi.h"
+#include "BatchIntegration.h"
+#include "BatchedOde.h"
+#include "BigNumber.h"
+#include "CompressedPipeline.h"
+#include "CumulativeIntegral.h"
+#include "GenzBenchmark.h"
+#include "Integration.h"
+#include "IntegrationEngine.h"
+#include "IntegrationScheduler.h"
+#include "LatticeCounter.h"
+#include "LiveResults.h"
+#include "MonteCarlo.h"
+#include "OscillatoryIntegral.h"
+#include "QueueBenchmark.h"
+#include "RequestCoalescer.h"
+#include "ResultsStore.h"
+#include "ResultsWriter.h"
+#include "SeriesAcceleration.h"
+#include "StreamIntegrator.h"
+#include "SweepScheduler.h"
+#include "Tracing.h"
 
 using namespace std;
 
@@ -56,16 +82,126 @@ double f(double x) {
  *   a wszystkie wyniki są sumowane w zmiennej \p result.
  */
 void calculatePartialIntegral(double start, double end, long long steps, double stepSize, double& result) {
+    long long firstStep = llround(start / stepSize); ///< Numer pierwszego kroku (identyfikator fragmentu w sondach).
+    PI_TRACE2(chunk_start, firstStep, steps);
     double sum = 0.0; ///< Suma wartości prostokątów w przedziale.
     for (long long i = 0; i < steps; ++i) {
         double x = start + i * stepSize + stepSize / 2.0; ///< Środek prostokąta w bieżącym kroku.
         sum += f(x) * stepSize; ///< Dodanie pola prostokąta do sumy.
     }
     result = sum; ///< Zapisanie wyniku całkowania w przedziale do zmiennej \p result.
+    PI_TRACE2(chunk_end, firstStep, steps);
 }
 
 /**
- * @brief Funkcja główna programu.
+ * @brief Wariant calculatePartialIntegral() publikujący postęp wątku.
+ *
+ * Pętla jest podzielona na bloki po 2^22 kroków; po każdym bloku liczba
+ * wykonanych kroków trafia do \p progress (jeden zapis bez synchronizacji na
+ * kilka milionów iteracji). Kolejność sumowania się nie zmienia, więc wynik
+ * jest identyczny jak w calculatePartialIntegral().
+ *
+ * @param progress Licznik postępu wątku w segmencie LiveResults.
+ */
+void calculatePartialIntegralTracked(double start, double /*end*/, long long steps, double stepSize, double& result,
+    atomic<int64_t>* progress) {
+    const long long block = 1LL << 22; ///< Liczba kroków między publikacjami postępu.
+    long long firstStep = llround(start / stepSize);
+    PI_TRACE2(chunk_start, firstStep, steps);
+    double sum = 0.0;
+    for (long long first = 0; first < steps; first += block) {
+        long long last = min(steps, first + block);
+        for (long long i = first; i < last; ++i) {
+            double x = start + i * stepSize + stepSize / 2.0;
+            sum += f(x) * stepSize;
+        }
+        progress->store(last, memory_order_relaxed);
+    }
+    result = sum;
+    PI_TRACE2(chunk_end, firstStep, steps);
+}
+
+/**
+ * @brief Oblicza liczbę PI metodą prostokątów, dzieląc \p steps kroków między \p numThreads nowych wątków.
+ *
+ * Jedna komórka przeglądu wydajności: wątki są tworzone przy każdym wywołaniu,
+ * tak jak w runSweep(), więc czas obejmuje również koszt ich uruchomienia.
+ *
+ * @param steps Liczba kroków całkowania.
+ * @param numThreads Liczba wątków.
+ * @param live Segment publikujący postęp wątków lub nullptr.
+ * @return Przybliżona wartość liczby PI.
+ */
+double calculatePi(long long steps, int numThreads, LiveResults* live) {
+    /**
+     * @brief Długość jednego kroku (delta x).
+     *
+     * Dla danego kroku całkowania obliczana jest szerokość prostokąta
+     * jako \( \text{stepSize} = \frac{1}{\text{steps}} \).
+     */
+    double stepSize = 1.0 / static_cast<double>(steps);
+    PI_TRACE2(integration_start, steps, numThreads);
+
+    vector<thread> threads; ///< Wektor przechowujący obiekty wątków.
+    vector<double> partialResults(numThreads, 0.0); ///< Wyniki obliczeń dla poszczególnych wątków.
+
+    // Podział pracy na wątki
+    /**
+     * @brief Liczba kroków przypadających na każdy wątek.
+     *
+     * Całkowity zakres obliczeń \p steps jest dzielony równomiernie na wątki.
+     */
+    long long stepsPerThread = steps / numThreads;
+    for (int i = 0; i < numThreads; ++i) {
+        /**
+         * @brief Początek i koniec zakresu dla bieżącego wątku.
+         *
+         * Każdy wątek obsługuje inny podprzedział całkowania,
+         * obliczany na podstawie numeru wątku i \p stepsPerThread.
+         */
+        double start = i * stepsPerThread * stepSize;
+        double end = (i + 1) * stepsPerThread * stepSize;
+
+        // Tworzenie i uruchamianie wątku (z publikacją postępu, jeśli jest dla niego miejsce w segmencie)
+        atomic<int64_t>* progress = live ? live->workerProgress(i) : nullptr;
+        if (progress) {
+            threads.emplace_back(calculatePartialIntegralTracked, start, end, stepsPerThread, stepSize, ref(partialResults[i]), progress);
+        }
+        else {
+            threads.emplace_back(calculatePartialIntegral, start, end, stepsPerThread, stepSize, ref(partialResults[i]));
+        }
+    }
+
+    // Czekanie na zakończenie wszystkich wątków
+    /**
+     * @brief Synchronizacja wątków.
+     *
+     * Program czeka, aż wszystkie wątki zakończą swoje obliczenia,
+     * zanim przejdzie do kolejnych kroków.
+     */
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    // Sumowanie wyników częściowych
+    /**
+     * @brief Przybliżona wartość liczby PI.
+     *
+     * Wynik obliczeń dla danego zestawu parametrów (liczby kroków i wątków).
+     * Sumowane są wyniki częściowe z każdego wątku.
+     */
+    PI_TRACE1(reduction_start, numThreads);
+    double pi = 0.0;
+    for (double result : partialResults) {
+        pi += result;
+    }
+    PI_TRACE1(reduction_end, numThreads);
+    PI_TRACE2(integration_end, steps, numThreads);
+    return pi;
+}
+
+/**
+ * @brief Przegląd wydajności dla różnych liczb wątków i kroków.
  *
  * Funkcja sterująca, która wykonuje obliczenia liczby PI metodą całkowania numerycznego
  * dla różnych konfiguracji liczby wątków i kroków. Program obsługuje wielowątkowość,
@@ -83,7 +219,7 @@ void calculatePartialIntegral(double start, double end, long long steps, double
  *   - Sumuje wyniki z poszczególnych wątków.
  *   - Zapisuje wyniki do pliku CSV.
  */
-int main() {
+int runSweep() {
     // Parametry testowe
     vector<long long> stepCounts = { 100000000, 1000000000, 3000000000 }; ///< Liczby podziałów (ilość kroków dla całkowania).
     int maxThreads = 50; ///< Maksymalna liczba wątków do testowania równoległych obliczeń.
@@ -95,98 +231,50 @@ int main() {
         return 1; ///< Kod błędu w przypadku niepowodzenia otwarcia pliku.
     }
     outputFile << "Liczba krokow,Liczba watków,Czas (s),Przyblizona liczba PI\n"; ///< Nagłówek pliku CSV.
+    // results.csv zawiera tylko bieżący przegląd, a magazyn gromadzi wyniki wszystkich uruchomień
+    ResultsStore store("results.pilog"); ///< Trwały magazyn wyników (tryb `history`).
+    if (!store.isOpen()) {
+        cerr << "Uwaga: nie można otworzyć magazynu results.pilog - wyniki trafią tylko do CSV." << endl;
+    }
+    ResultsWriter writer(outputFile, &cout, store.isOpen() ? &store : nullptr); ///< Wątek zapisujący wyniki poza ścieżką pomiaru.
+    LiveResults live; ///< Bieżące wyniki w pamięci współdzielonej dla zewnętrznych monitorów (tryb `live`).
 
     // Iteracja przez różne liczby kroków
     for (long long steps : stepCounts) {
-        /**
-         * @brief Długość jednego kroku (delta x).
-         *
-         * Dla danego kroku całkowania obliczana jest szerokość prostokąta
-         * jako \( \text{stepSize} = \frac{1}{\text{steps}} \).
-         */
-        double stepSize = 1.0 / static_cast<double>(steps);
-
         // Iteracja przez liczbę wątków
         for (int numThreads = 1; numThreads <= maxThreads; ++numThreads) {
-            vector<thread> threads; ///< Wektor przechowujący obiekty wątków.
-            vector<double> partialResults(numThreads, 0.0); ///< Wyniki obliczeń dla poszczególnych wątków.
-
             /**
              * @brief Rejestracja czasu rozpoczęcia obliczeń.
              *
              * Używane do pomiaru wydajności dla każdej konfiguracji liczby kroków i wątków.
              */
+            live.beginCell(steps, numThreads);
             auto startTime = chrono::high_resolution_clock::now();
 
-            // Podział pracy na wątki
-            /**
-             * @brief Liczba kroków przypadających na każdy wątek.
-             *
-             * Całkowity zakres obliczeń \p steps jest dzielony równomiernie na wątki.
-             */
-            long long stepsPerThread = steps / numThreads;
-            for (int i = 0; i < numThreads; ++i) {
-                /**
-                 * @brief Początek i koniec zakresu dla bieżącego wątku.
-                 *
-                 * Każdy wątek obsługuje inny podprzedział całkowania,
-                 * obliczany na podstawie numeru wątku i \p stepsPerThread.
-                 */
-                double start = i * stepsPerThread * stepSize;
-                double end = (i + 1) * stepsPerThread * stepSize;
-
-                // Tworzenie i uruchamianie wątku
-                threads.emplace_back(calculatePartialIntegral, start, end, stepsPerThread, stepSize, ref(partialResults[i]));
-            }
-
-            // Czekanie na zakończenie wszystkich wątków
-            /**
-             * @brief Synchronizacja wątków.
-             *
-             * Program czeka, aż wszystkie wątki zakończą swoje obliczenia,
-             * zanim przejdzie do kolejnych kroków.
-             */
-            for (auto& t : threads) {
-                t.join();
-            }
-
-            // Sumowanie wyników częściowych
-            /**
-             * @brief Przybliżona wartość liczby PI.
-             *
-             * Wynik obliczeń dla danego zestawu parametrów (liczby kroków i wątków).
-             * Sumowane są wyniki częściowe z każdego wątku.
-             */
-            double pi = 0.0;
-            for (double result : partialResults) {
-                pi += result;
-            }
+            // Obliczenia w nowych wątkach (patrz calculatePi())
+            double pi = calculatePi(steps, numThreads, live.isOpen() ? &live : nullptr);
 
             // Rejestracja czasu zakończenia obliczeń
             auto endTime = chrono::high_resolution_clock::now();
             chrono::duration<double> duration = endTime - startTime; ///< Czas trwania obliczeń.
 
-            // Zapis wyników do pliku CSV
+            // Zapis wyników do pliku CSV i na konsolę
             /**
-             * @brief Zapis wyników do pliku.
+             * @brief Przekazanie wyników do wątku zapisującego.
              *
              * Dla każdej kombinacji liczby kroków i wątków zapisane są:
              * - Liczba kroków całkowania.
              * - Liczba wątków użytych w obliczeniach.
              * - Czas trwania obliczeń w sekundach.
              * - Przybliżona wartość liczby PI.
-             */
-            outputFile << steps << "," << numThreads << "," << duration.count() << "," << pi << "\n";
-
-            // Wyświetlanie wyników na konsoli
-            /**
-             * @brief Wyświetlanie wyników na konsoli.
              *
-             * Wyniki obliczeń są również wyświetlane w konsoli, co pozwala
-             * użytkownikowi śledzić postęp działania programu.
+             * Wiersz trafia tylko do kolejki bez blokad; zapis do pliku i na konsolę
+             * wykonuje ResultsWriter po zakończeniu przeglądu (lub przy pełnej kolejce),
+             * więc operacje wejścia-wyjścia nie nakładają się na kolejne pomiary.
+             * Postęp na bieżąco pokazuje tryb `live`.
              */
-            cout << "Liczba kroków: " << steps << ", Wątki: " << numThreads
-                << ", Czas: " << duration.count() << "s, PI: " << pi << endl;
+            writer.submit({ steps, numThreads, duration.count(), pi });
+            live.publishRow({ steps, numThreads, duration.count(), pi });
         }
     }
 
@@ -195,10 +283,126 @@ int main() {
      * @brief Zamykanie pliku CSV.
      *
      * Plik wyników jest zamykany po zapisaniu wszystkich danych, aby upewnić się,
-     * że dane zostały prawidłowo zapisane i zwolnić zasoby.
+     * że dane zostały prawidłowo zapisane i zwolnić zasoby. Najpierw wątek
+     * zapisujący opróżnia swoją kolejkę.
      */
+    live.finish();
+    writer.close();
     outputFile.close();
     cout << "Wyniki zapisane do pliku results.csv" << endl;
 
     return 0; ///< Zwraca 0, jeśli program zakończył się poprawnie.
 }
+
+/**
+ * @brief Funkcja główna programu.
+ *
+ * Bez argumentów program wykonuje przegląd wydajności (runSweep()). Pierwszy argument
+ * pozwala wybrać inny tryb pracy:
+ * - `stream` – całkowanie strumienia próbek ze standardowego wejścia lub pliku,
+ * - `cumulative` – całka narastająca F(x) w każdym punkcie siatki,
+ * - `compressed` – całkowanie próbek z pliku LZ4 z równoległą dekompresją,
+ * - `lattice` – dokładne zliczanie punktów kratowych w kole (kontrola bez błędów zaokrągleń),
+ * - `series` – szeregi Leibniza i Wallisa z metodami przyspieszania zbieżności,
+ * - `agm` – cyfry liczby PI algorytmem Gaussa-Legendre'a (AGM) w dowolnej precyzji,
+ * - `bigmul` – porównanie algorytmów mnożenia dużych liczb (strojenie kaskady),
+ * - `vegas` – adaptacyjne całkowanie Monte Carlo (VEGAS) w wielu wymiarach,
+ * - `miser` – Monte Carlo z rekurencyjną stratyfikacją (MISER) w porównaniu ze zwykłym,
+ * - `oscillatory` – całki g(x)·sin(ωx) i g(x)·cos(ωx) metodami Filona i Levina,
+ * - `ode` – wsadowe rozwiązywanie równań y' = 4/(1+t²) i podobnych metodą Dormanda-Prince'a,
+ * - `genz` – dokładność i koszt metod całkowania na funkcjach testowych Genza,
+ * - `adaptive` – przegląd wydajności mierzący tylko informacyjne liczby wątków,
+ * - `planned` – pełny przegląd w losowej kolejności z wykrywaniem dryfu,
+ * - `budgeted` – przegląd z przewidywaniem czasu i ograniczeniem do budżetu,
+ * - `throughput` – komórki przeglądu wykonywane współbieżnie na rozłącznych grupach rdzeni,
+ * - `history` – zapytania o wyniki wszystkich uruchomień zgromadzone w magazynie results.pilog,
+ * - `live` – podgląd przeglądu wykonywanego przez inny proces (pamięć współdzielona),
+ * - `alloc` – alokacje na stercie na jedno całkowanie: calculatePi() a silnik bez alokacji,
+ * - `queue` – przepustowość kolejki zadań bez blokad w porównaniu z kolejką z muteksem,
+ * - `priority` – opóźnienia pilnych całkowań obok dużych zadań tła (priorytety, terminy, fragmenty),
+ * - `coalesce` – łączenie jednoczesnych identycznych zgłoszeń całkowania w jedno obliczenie,
+ * - `nested` – wsady równoległych całkowań na jednej puli (zagnieżdżona równoległość bez nadsubskrypcji).
+ *
+ * @param argc Liczba argumentów programu.
+ * @param argv Tablica argumentów programu.
+ * @return Kod zakończenia wybranego trybu.
+ */
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        return runSweep();
+    }
+
+    string mode = argv[1];
+    if (mode == "stream") {
+        return runStreamMode(argc, argv);
+    }
+    if (mode == "cumulative") {
+        return runCumulativeMode(argc, argv);
+    }
+    if (mode == "compressed") {
+        return runCompressedMode(argc, argv);
+    }
+    if (mode == "lattice") {
+        return runLatticeMode(argc, argv);
+    }
+    if (mode == "series") {
+        return runSeriesMode(argc, argv);
+    }
+    if (mode == "agm") {
+        return runAgmMode(argc, argv);
+    }
+    if (mode == "bigmul") {
+        return runMultiplyBenchmark(argc, argv);
+    }
+    if (mode == "vegas") {
+        return runVegasMode(argc, argv);
+    }
+    if (mode == "miser") {
+        return runMiserMode(argc, argv);
+    }
+    if (mode == "oscillatory") {
+        return runOscillatoryMode(argc, argv);
+    }
+    if (mode == "ode") {
+        return runOdeMode(argc, argv);
+    }
+    if (mode == "genz") {
+        return runGenzMode(argc, argv);
+    }
+    if (mode == "adaptive") {
+        return runAdaptiveSweepMode(argc, argv);
+    }
+    if (mode == "planned") {
+        return runPlannedSweepMode(argc, argv);
+    }
+    if (mode == "budgeted") {
+        return runBudgetedSweepMode(argc, argv);
+    }
+    if (mode == "throughput") {
+        return runThroughputSweepMode(argc, argv);
+    }
+    if (mode == "history") {
+        return runHistoryMode(argc, argv);
+    }
+    if (mode == "live") {
+        return runLiveMode(argc, argv);
+    }
+    if (mode == "alloc") {
+        return runAllocationMode(argc, argv);
+    }
+    if (mode == "queue") {
+        return runQueueMode(argc, argv);
+    }
+    if (mode == "priority") {
+        return runPriorityMode(argc, argv);
+    }
+    if (mode == "coalesce") {
+        return runCoalesceMode(argc, argv);
+    }
+    if (mode == "nested") {
+        return runNestedMode(argc, argv);
+    }
+
+    cerr << "Nieznany tryb: " << mode << endl;
+    return 1;
+}
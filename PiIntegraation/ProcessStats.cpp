@@ -0,0 +1,37 @@
+﻿/**
+ * @file ProcessStats.cpp
+ * @brief Implementacja statystyk procesu dla Windows i systemów POSIX.
+ */
+
+#include "ProcessStats.h"
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#else
+#include <sys/resource.h>
+#endif
+
+using namespace std;
+
+size_t peakMemoryBytes() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return counters.PeakWorkingSetSize;
+    }
+    return 0;
+#else
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+#ifdef __APPLE__
+    return static_cast<size_t>(usage.ru_maxrss); // macOS podaje bajty
+#else
+    return static_cast<size_t>(usage.ru_maxrss) * 1024; // Linux podaje kilobajty
+#endif
+#endif
+}
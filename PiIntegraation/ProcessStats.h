@@ -0,0 +1,16 @@
+﻿/**
+ * @file ProcessStats.h
+ * @brief Statystyki procesu (szczytowe zużycie pamięci) dla raportów wydajności.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+/**
+ * @brief Szczytowe zużycie pamięci fizycznej przez proces w bajtach.
+ *
+ * Windows: PeakWorkingSetSize, POSIX: ru_maxrss. Zwraca 0, jeśli system
+ * nie udostępnia tej informacji.
+ */
+std::size_t peakMemoryBytes();
@@ -0,0 +1,167 @@
+﻿/**
+ * @file QueueBenchmark.cpp
+ * @brief Implementacja pomiaru MpmcQueue<Task> i kolejki z muteksem.
+ */
+
+#include "QueueBenchmark.h"
+#include "AllocationCounter.h"
+#include "BoundedQueue.h"
+#include "CommandLine.h"
+#include "MpmcQueue.h"
+#include "Task.h"
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+thread_local double consumedSum = 0.0;
+
+/**
+ * @brief Domknięcie o rozmiarze typowym dla fragmentu całki (40 bajtów).
+ */
+auto makeChunkClosure(long long item, double* result) {
+    double start = static_cast<double>(item);
+    long long steps = item % 7 + 1;
+    double stepSize = 0.5;
+    int chunk = static_cast<int>(item % 64);
+    return [start, steps, stepSize, result, chunk] {
+        consumedSum += start + steps * stepSize + chunk;
+        if (result && steps < 0) {
+            *result = consumedSum; // Nigdy nie wykonywane - tylko rozmiar domknięcia
+        }
+    };
+}
+
+/// Rozdziela \p items zadań między \p producers producentów.
+long long producerShare(long long items, int producers, int producer) {
+    return items * (producer + 1) / producers - items * producer / producers;
+}
+
+/// Wynik jednego pomiaru: czas i alokacje.
+struct QueueRun {
+    double seconds = 0.0;
+    long long allocations = 0;
+};
+
+QueueRun runLockFree(long long items, int threads, size_t capacity) {
+    MpmcQueue<Task> queue(capacity);
+    AllocationCounters before = processAllocations();
+    auto startTime = chrono::high_resolution_clock::now();
+    vector<thread> workers;
+    workers.reserve(2 * threads);
+    for (int c = 0; c < threads; ++c) {
+        workers.emplace_back([&] {
+            Task task;
+            for (;;) {
+                if (!queue.tryPop(task)) {
+                    this_thread::yield();
+                    continue;
+                }
+                if (!task) {
+                    return; // Zadanie puste - sygnał końca
+                }
+                task();
+                task = Task();
+            }
+        });
+    }
+    for (int p = 0; p < threads; ++p) {
+        workers.emplace_back([&, p] {
+            long long first = items * p / threads;
+            long long count = producerShare(items, threads, p);
+            for (long long i = first; i < first + count; ++i) {
+                Task task(makeChunkClosure(i, nullptr));
+                while (!queue.tryPush(std::move(task))) {
+                    this_thread::yield();
+                }
+            }
+        });
+    }
+    for (int p = threads; p < 2 * threads; ++p) {
+        workers[p].join();
+    }
+    for (int c = 0; c < threads; ++c) {
+        Task stop;
+        while (!queue.tryPush(std::move(stop))) {
+            this_thread::yield();
+        }
+    }
+    for (int c = 0; c < threads; ++c) {
+        workers[c].join();
+    }
+    chrono::duration<double> duration = chrono::high_resolution_clock::now() - startTime;
+    QueueRun run;
+    run.seconds = duration.count();
+    run.allocations = (processAllocations() - before).allocations;
+    return run;
+}
+
+QueueRun runLocked(long long items, int threads, size_t capacity) {
+    BoundedQueue<function<void()>> queue(capacity);
+    AllocationCounters before = processAllocations();
+    auto startTime = chrono::high_resolution_clock::now();
+    vector<thread> workers;
+    workers.reserve(2 * threads);
+    for (int c = 0; c < threads; ++c) {
+        workers.emplace_back([&] {
+            function<void()> task;
+            while (queue.pop(task)) {
+                task();
+            }
+        });
+    }
+    for (int p = 0; p < threads; ++p) {
+        workers.emplace_back([&, p] {
+            long long first = items * p / threads;
+            long long count = producerShare(items, threads, p);
+            for (long long i = first; i < first + count; ++i) {
+                queue.push(makeChunkClosure(i, nullptr));
+            }
+        });
+    }
+    for (int p = threads; p < 2 * threads; ++p) {
+        workers[p].join();
+    }
+    queue.close();
+    for (int c = 0; c < threads; ++c) {
+        workers[c].join();
+    }
+    chrono::duration<double> duration = chrono::high_resolution_clock::now() - startTime;
+    QueueRun run;
+    run.seconds = duration.count();
+    run.allocations = (processAllocations() - before).allocations;
+    return run;
+}
+
+} // namespace
+
+int runQueueMode(int argc, char* argv[]) {
+    long long items = max(1LL, getIntOption(argc, argv, "--items", 200000));
+    int maxThreads = static_cast<int>(max(1LL, getIntOption(argc, argv, "--max-threads", 64)));
+    size_t capacity = static_cast<size_t>(max(2LL, getIntOption(argc, argv, "--capacity", 1024)));
+
+    using Closure = decltype(makeChunkClosure(0, nullptr));
+    cout << "Zadania: " << items << ", Pojemność: " << capacity << ", Rozmiar domknięcia: " << sizeof(Closure)
+        << " B, W buforze Task: " << (Task::fitsInline<Closure>() ? "tak" : "nie") << endl;
+
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        QueueRun lockFree = runLockFree(items, threads, capacity);
+        QueueRun locked = runLocked(items, threads, capacity);
+        auto report = [&](const char* name, const QueueRun& run) {
+            cout << "Kolejka: " << name << ", Producenci/konsumenci: " << threads
+                << ", Operacje/s: " << static_cast<double>(items) / run.seconds
+                << ", Alokacje/zadanie: " << static_cast<double>(run.allocations) / items
+                << ", Czas: " << run.seconds << "s" << endl;
+        };
+        report("MpmcQueue<Task>", lockFree);
+        report("muteks + std::function", locked);
+    }
+    return 0;
+}
@@ -0,0 +1,23 @@
+﻿/**
+ * @file QueueBenchmark.h
+ * @brief Pomiar przepustowości kolejek zadań puli wątków.
+ */
+
+#pragma once
+
+/**
+ * @brief Uruchamia tryb `queue` - wstawianie i pobieranie zadań przez P producentów i P konsumentów.
+ *
+ * Porównywane są:
+ * - MpmcQueue<Task> - kolejka bez blokad z zadaniami bez alokacji (jak w ThreadPool),
+ * - BoundedQueue<std::function<void()>> - muteks, std::deque i std::function.
+ *
+ * Zadaniem jest domknięcie o rozmiarze typowym dla fragmentu całki (zakres,
+ * krok, wskaźnik na wynik). Dla każdej liczby wątków wypisywana jest liczba
+ * operacji (wstawienie + pobranie + wykonanie) na sekundę i alokacje na zadanie.
+ * Opcje: `--items n` (domyślnie 200000), `--max-threads n` (domyślnie 64,
+ * liczby wątków to kolejne potęgi dwójki), `--capacity n` (domyślnie 1024).
+ *
+ * @return Kod zakończenia programu.
+ */
+int runQueueMode(int argc, char* argv[]);
@@ -0,0 +1,99 @@
+﻿/**
+ * @file RequestCoalescer.cpp
+ * @brief Implementacja łączenia zgłoszeń i trybu `coalesce`.
+ */
+
+#include "RequestCoalescer.h"
+#include "CommandLine.h"
+
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+shared_future<IntegrationOutcome> RequestCoalescer::integrate(const IntegrationRequest& request, bool* joined) {
+    IntegrationKey key;
+    key.integrand = "4/(1+x^2)";
+    key.lower = request.lower;
+    key.upper = request.upper;
+    key.method = "prostokąty";
+    key.steps = request.steps;
+    key.priority = static_cast<int>(request.priority);
+    return flights.run(key, [&](promise<IntegrationOutcome> result) { scheduler.submit(request, move(result)); }, joined);
+}
+
+int runCoalesceMode(int argc, char* argv[]) {
+    int clients = static_cast<int>(max(1LL, getIntOption(argc, argv, "--clients", 16)));
+    int requests = static_cast<int>(max(1LL, getIntOption(argc, argv, "--requests", 4)));
+    int distinct = static_cast<int>(max(1LL, getIntOption(argc, argv, "--distinct", 2)));
+    long long baseSteps = max(1LL, getIntOption(argc, argv, "--steps", 20000000));
+    unsigned seed = static_cast<unsigned>(getIntOption(argc, argv, "--seed", 1));
+    int numThreads = static_cast<int>(getIntOption(argc, argv, "--threads", thread::hardware_concurrency()));
+
+    ThreadPool pool(static_cast<unsigned>(max(1, numThreads)));
+    cout << "Wątki: " << pool.size() << ", Klienci: " << clients << " × " << requests << " zgłoszeń, Różne całki: " << distinct << endl;
+
+    // Wspólny plan zgłoszeń dla obu scenariuszy
+    vector<vector<long long>> plan(clients);
+    mt19937 generator(seed);
+    uniform_int_distribution<int> pick(0, distinct - 1);
+    for (auto& client : plan) {
+        for (int r = 0; r < requests; ++r) {
+            client.push_back(baseSteps + pick(generator));
+        }
+    }
+
+    auto runScenario = [&](const char* name, bool coalesce) {
+        IntegrationScheduler scheduler(pool, SchedulerOptions());
+        RequestCoalescer coalescer(scheduler);
+        mutex resultsMutex;
+        map<long long, double> firstResult;
+        bool consistent = true;
+        atomic<long long> executions{ 0 };
+
+        auto startTime = chrono::steady_clock::now();
+        vector<thread> threads;
+        for (int c = 0; c < clients; ++c) {
+            threads.emplace_back([&, c] {
+                for (long long steps : plan[c]) {
+                    IntegrationRequest request;
+                    request.steps = steps;
+                    double value;
+                    if (coalesce) {
+                        value = coalescer.integrate(request).get().pi;
+                    }
+                    else {
+                        ++executions;
+                        value = scheduler.submit(request).get().pi;
+                    }
+                    lock_guard<mutex> lock(resultsMutex);
+                    auto [it, inserted] = firstResult.emplace(steps, value);
+                    consistent = consistent && (inserted || it->second == value);
+                }
+            });
+        }
+        for (auto& t : threads) {
+            t.join();
+        }
+        chrono::duration<double> duration = chrono::steady_clock::now() - startTime;
+
+        SingleFlightMetrics metrics = coalescer.metrics();
+        if (!coalesce) {
+            metrics.requests = metrics.executions = executions;
+        }
+        cout << "Łączenie: " << name << ", Czas: " << duration.count() << "s, Zgłoszenia: " << metrics.requests
+            << ", Obliczenia: " << metrics.executions << ", Połączone: " << metrics.coalesced
+            << ", Wyniki zgodne: " << (consistent ? "tak" : "nie") << endl;
+        return consistent;
+    };
+
+    bool consistent = runScenario("wyłączone", false);
+    consistent = runScenario("włączone", true) && consistent;
+    return consistent ? 0 : 1;
+}
@@ -0,0 +1,70 @@
+﻿/**
+ * @file RequestCoalescer.h
+ * @brief Deduplikacja jednoczesnych identycznych zgłoszeń całkowania.
+ *
+ * Gdy wielu klientów jednocześnie prosi o tę samą całkę, każde zgłoszenie
+ * uruchamiałoby pełne równoległe obliczenie. RequestCoalescer kieruje
+ * zgłoszenia do IntegrationScheduler przez SingleFlight: zgłoszenia o tym
+ * samym kluczu (funkcja podcałkowa, granice, metoda, liczba kroków, klasa
+ * priorytetu) zgłoszone w trakcie obliczenia dostają jego wynik.
+ *
+ * Klasa priorytetu jest częścią klucza, aby pilne zgłoszenie nigdy nie czekało
+ * na identyczne obliczenie tła. Termin nie jest częścią klucza - dołączające
+ * zgłoszenie przejmuje termin lidera.
+ */
+
+#pragma once
+
+#include "IntegrationScheduler.h"
+#include "SingleFlight.h"
+
+#include <string>
+#include <tuple>
+
+/**
+ * @brief Klucz deduplikacji zgłoszeń całkowania.
+ */
+struct IntegrationKey {
+    std::string integrand; ///< Funkcja podcałkowa, np. "4/(1+x^2)".
+    double lower = 0.0;
+    double upper = 1.0;
+    std::string method;    ///< Metoda całkowania, np. "prostokąty".
+    long long steps = 0;
+    int priority = 0;
+
+    bool operator<(const IntegrationKey& other) const {
+        return std::tie(integrand, lower, upper, method, steps, priority)
+            < std::tie(other.integrand, other.lower, other.upper, other.method, other.steps, other.priority);
+    }
+};
+
+/**
+ * @brief Pośrednik łączący identyczne zgłoszenia przed IntegrationScheduler.
+ */
+class RequestCoalescer {
+public:
+    explicit RequestCoalescer(IntegrationScheduler& scheduler) : scheduler(scheduler) {}
+
+    /// Zgłasza całkowanie lub dołącza do identycznego obliczenia w toku.
+    std::shared_future<IntegrationOutcome> integrate(const IntegrationRequest& request, bool* joined = nullptr);
+
+    /// Liczniki zgłoszeń, obliczeń i zgłoszeń połączonych.
+    SingleFlightMetrics metrics() { return flights.metrics(); }
+
+private:
+    IntegrationScheduler& scheduler;
+    SingleFlight<IntegrationKey, IntegrationOutcome> flights;
+};
+
+/**
+ * @brief Uruchamia tryb `coalesce` - wielu klientów zgłaszających te same całki jednocześnie.
+ *
+ * `--clients` wątków klientów zgłasza po `--requests` całkowań, losując jedną
+ * z `--distinct` różnych całek (różne liczby kroków, bazowo `--steps`).
+ * Scenariusz jest wykonywany bez łączenia i z łączeniem zgłoszeń; wypisywany
+ * jest czas, liczba obliczeń, liczba połączonych zgłoszeń oraz zgodność
+ * wyników dla tych samych kluczy. Opcje: `--threads n` (rozmiar puli), `--seed n`.
+ *
+ * @return Kod zakończenia programu.
+ */
+int runCoalesceMode(int argc, char* argv[]);
@@ -0,0 +1,514 @@
+﻿/**
+ * @file ResultsStore.cpp
+ * @brief Implementacja dziennika wyników, jego indeksu i trybu `history`.
+ */
+
+#include "ResultsStore.h"
+#include "CommandLine.h"
+
+#include <chrono>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+#endif
+
+// GitCommit.h generuje krok PreBuildEvent projektu (git rev-parse --short HEAD).
+#if __has_include("GitCommit.h")
+#include "GitCommit.h"
+#endif
+
+#ifndef PI_GIT_COMMIT
+#define PI_GIT_COMMIT "unknown"
+#endif
+
+using namespace std;
+
+namespace {
+
+const char logMagic[8] = { 'P', 'I', 'L', 'O', 'G', 0, 0, 1 };
+const char indexMagic[8] = { 'P', 'I', 'I', 'D', 'X', 0, 0, 1 };
+constexpr uint64_t logHeaderSize = sizeof(logMagic);
+constexpr uint64_t indexHeaderSize = sizeof(indexMagic) + sizeof(uint64_t);
+constexpr uint32_t maxRecordSize = 1 << 16;
+
+static_assert(sizeof(ResultsStore::IndexEntry) == 64, "Wpis indeksu musi mieć stały rozmiar 64 bajtów");
+
+uint64_t fnv1a(const string& text) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (unsigned char c : text) {
+        hash = (hash ^ c) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+uint32_t checksum(const string& bytes) {
+    uint32_t hash = 2166136261u;
+    for (unsigned char c : bytes) {
+        hash = (hash ^ c) * 16777619u;
+    }
+    return hash;
+}
+
+template <typename T>
+void put(string& out, T value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void putString(string& out, const string& text) {
+    put(out, static_cast<uint16_t>(min<size_t>(text.size(), 0xFFFF)));
+    out.append(text, 0, min<size_t>(text.size(), 0xFFFF));
+}
+
+/**
+ * @brief Sekwencyjny odczyt pól z ładunku rekordu; failed ustawiane po przekroczeniu końca.
+ */
+struct Reader {
+    const string& bytes;
+    size_t position = 0;
+    bool failed = false;
+
+    template <typename T>
+    T get() {
+        T value{};
+        if (position + sizeof(T) > bytes.size()) {
+            failed = true;
+            return value;
+        }
+        memcpy(&value, bytes.data() + position, sizeof(T));
+        position += sizeof(T);
+        return value;
+    }
+
+    string getString() {
+        uint16_t length = get<uint16_t>();
+        if (failed || position + length > bytes.size()) {
+            failed = true;
+            return string();
+        }
+        string text = bytes.substr(position, length);
+        position += length;
+        return text;
+    }
+};
+
+string serialize(const StoredResult& result) {
+    string payload;
+    put<int64_t>(payload, result.timestamp);
+    put<int64_t>(payload, result.steps);
+    put<int32_t>(payload, result.threads);
+    put<double>(payload, result.seconds);
+    put<double>(payload, result.pi);
+    putString(payload, result.host);
+    putString(payload, result.method);
+    putString(payload, result.commit);
+    return payload;
+}
+
+bool deserialize(const string& payload, StoredResult& result) {
+    Reader reader{ payload };
+    result.timestamp = reader.get<int64_t>();
+    result.steps = reader.get<int64_t>();
+    result.threads = reader.get<int32_t>();
+    result.seconds = reader.get<double>();
+    result.pi = reader.get<double>();
+    result.host = reader.getString();
+    result.method = reader.getString();
+    result.commit = reader.getString();
+    return !reader.failed && reader.position == payload.size();
+}
+
+/**
+ * @brief Czyta rekord z pozycji \p offset: [długość u32][ładunek][suma kontrolna u32].
+ * @return Pozycja następnego rekordu lub 0, jeśli rekord jest niepełny albo uszkodzony.
+ */
+uint64_t readRecord(ifstream& log, uint64_t offset, StoredResult& result) {
+    log.clear();
+    log.seekg(static_cast<streamoff>(offset));
+    uint32_t length = 0;
+    if (!log.read(reinterpret_cast<char*>(&length), sizeof(length)) || length > maxRecordSize) {
+        return 0;
+    }
+    string payload(length, '\0');
+    uint32_t stored = 0;
+    if (!log.read(payload.data(), length) || !log.read(reinterpret_cast<char*>(&stored), sizeof(stored))) {
+        return 0;
+    }
+    if (stored != checksum(payload) || !deserialize(payload, result)) {
+        return 0;
+    }
+    return offset + sizeof(length) + length + sizeof(stored);
+}
+
+ResultsStore::IndexEntry makeEntry(const StoredResult& result, uint64_t offset) {
+    ResultsStore::IndexEntry entry{};
+    entry.hostHash = fnv1a(result.host);
+    entry.methodHash = fnv1a(result.method);
+    entry.commitHash = fnv1a(result.commit);
+    entry.steps = result.steps;
+    entry.threads = result.threads;
+    entry.timestamp = result.timestamp;
+    entry.seconds = result.seconds;
+    entry.offset = offset;
+    return entry;
+}
+
+/**
+ * @brief Wyłączna blokada magazynu na czas zapisu lub synchronizacji indeksu.
+ *
+ * Blokowany jest osobny plik `path.lock` - na Windows LockFileEx blokuje
+ * również zapis przez inne uchwyty tego samego procesu, więc nie można nim
+ * zablokować samego dziennika, do którego zapisuje std::ofstream.
+ */
+class StoreLock {
+public:
+    explicit StoreLock(const string& path) {
+#ifdef _WIN32
+        handle = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+            nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        OVERLAPPED overlapped{};
+        if (handle != INVALID_HANDLE_VALUE && !LockFileEx(handle, LOCKFILE_EXCLUSIVE_LOCK, 0, 1, 0, &overlapped)) {
+            CloseHandle(handle);
+            handle = INVALID_HANDLE_VALUE;
+        }
+#else
+        descriptor = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+        if (descriptor >= 0 && flock(descriptor, LOCK_EX) != 0) {
+            close(descriptor);
+            descriptor = -1;
+        }
+#endif
+    }
+
+    ~StoreLock() {
+#ifdef _WIN32
+        if (handle != INVALID_HANDLE_VALUE) {
+            OVERLAPPED overlapped{};
+            UnlockFileEx(handle, 0, 1, 0, &overlapped);
+            CloseHandle(handle);
+        }
+#else
+        if (descriptor >= 0) {
+            flock(descriptor, LOCK_UN);
+            close(descriptor);
+        }
+#endif
+    }
+
+    StoreLock(const StoreLock&) = delete;
+    StoreLock& operator=(const StoreLock&) = delete;
+
+    /// Czy blokada została uzyskana.
+    bool locked() const {
+#ifdef _WIN32
+        return handle != INVALID_HANDLE_VALUE;
+#else
+        return descriptor >= 0;
+#endif
+    }
+
+private:
+#ifdef _WIN32
+    HANDLE handle = INVALID_HANDLE_VALUE;
+#else
+    int descriptor = -1;
+#endif
+};
+
+string formatTimestamp(long long timestamp) {
+    time_t time = static_cast<time_t>(timestamp);
+    tm parts{};
+#ifdef _WIN32
+    gmtime_s(&parts, &time);
+#else
+    gmtime_r(&time, &parts);
+#endif
+    ostringstream text;
+    text << put_time(&parts, "%Y-%m-%d %H:%M");
+    return text.str();
+}
+
+} // namespace
+
+ResultsStore::ResultsStore(const string& path, bool readOnly)
+    : logPath(path), indexPath(path + ".idx"), lockPath(path + ".lock"), readOnly(readOnly) {
+    error_code error;
+    if (readOnly && !filesystem::exists(logPath, error)) {
+        return;
+    }
+    StoreLock lock(lockPath);
+    if (!lock.locked()) {
+        cerr << "Nie można zablokować magazynu " << logPath << "." << endl;
+        return;
+    }
+    if (!filesystem::exists(logPath, error)) {
+        ofstream create(logPath, ios::binary);
+        create.write(logMagic, sizeof(logMagic));
+        if (!create) {
+            return;
+        }
+    }
+    ifstream log(logPath, ios::binary);
+    char magic[sizeof(logMagic)] = {};
+    if (!log.read(magic, sizeof(magic)) || memcmp(magic, logMagic, sizeof(magic)) != 0) {
+        cerr << "Plik " << logPath << " nie jest magazynem wyników." << endl;
+        return;
+    }
+    open = synchronizeIndex();
+}
+
+bool ResultsStore::synchronizeIndex() {
+    error_code error;
+    logSize = filesystem::file_size(logPath, error);
+    if (error) {
+        return false;
+    }
+    entries.clear();
+
+    // Wczytanie indeksu; nieprawidłowy lub dłuższy niż dziennik jest budowany od nowa
+    uint64_t covered = logHeaderSize;
+    bool changed = true;
+    {
+        ifstream index(indexPath, ios::binary);
+        char magic[sizeof(indexMagic)] = {};
+        uint64_t indexCovered = 0;
+        if (index.read(magic, sizeof(magic)) && memcmp(magic, indexMagic, sizeof(magic)) == 0
+            && index.read(reinterpret_cast<char*>(&indexCovered), sizeof(indexCovered)) && indexCovered <= logSize) {
+            IndexEntry entry;
+            while (index.read(reinterpret_cast<char*>(&entry), sizeof(entry))) {
+                entries.push_back(entry);
+            }
+            covered = indexCovered;
+            changed = false;
+            if (!entries.empty() && entries.back().offset >= covered) {
+                entries.clear();
+                covered = logHeaderSize;
+                changed = true;
+            }
+        }
+    }
+
+    // Dopisanie do indeksu rekordów, których jeszcze nie obejmuje. Uszkodzone dane są
+    // pomijane do następnego poprawnego rekordu (długość i suma kontrolna), a dziennik
+    // nigdy nie jest obcinany - mogą za nimi leżeć poprawne rekordy innego procesu.
+    ifstream log(logPath, ios::binary);
+    while (covered < logSize) {
+        StoredResult result;
+        uint64_t next = readRecord(log, covered, result);
+        if (next == 0) {
+            uint64_t damaged = covered;
+            do {
+                ++covered;
+                next = covered < logSize ? readRecord(log, covered, result) : 0;
+            } while (next == 0 && covered < logSize);
+            cerr << "Uwaga: pominięto " << covered - damaged << " B nieczytelnych danych w " << logPath
+                << " (od pozycji " << damaged << ")." << endl;
+            changed = true;
+            if (next == 0) {
+                break;
+            }
+        }
+        entries.push_back(makeEntry(result, covered));
+        covered = next;
+        changed = true;
+    }
+    if (changed && !readOnly) {
+        return writeIndex();
+    }
+    return true;
+}
+
+bool ResultsStore::writeIndex() const {
+    ofstream index(indexPath, ios::binary | ios::trunc);
+    index.write(indexMagic, sizeof(indexMagic));
+    index.write(reinterpret_cast<const char*>(&logSize), sizeof(logSize));
+    index.write(reinterpret_cast<const char*>(entries.data()), static_cast<streamsize>(entries.size() * sizeof(IndexEntry)));
+    return static_cast<bool>(index);
+}
+
+bool ResultsStore::append(const StoredResult& result) {
+    if (!open || readOnly) {
+        return false;
+    }
+    string payload = serialize(result);
+    uint32_t length = static_cast<uint32_t>(payload.size());
+    uint32_t sum = checksum(payload);
+
+    // Pod blokadą pozycja rekordu to rzeczywisty koniec dziennika; jeśli inny proces
+    // dopisał w międzyczasie, indeks jest najpierw wczytywany ponownie.
+    StoreLock lock(lockPath);
+    if (!lock.locked()) {
+        return false;
+    }
+    error_code error;
+    uint64_t end = filesystem::file_size(logPath, error);
+    if (error || (end != logSize && !synchronizeIndex())) {
+        return false;
+    }
+
+    // Najpierw dziennik, potem indeks - przerwany zapis indeksu zostanie odtworzony przy otwarciu
+    {
+        ofstream log(logPath, ios::binary | ios::app);
+        log.write(reinterpret_cast<const char*>(&length), sizeof(length));
+        log.write(payload.data(), length);
+        log.write(reinterpret_cast<const char*>(&sum), sizeof(sum));
+        if (!log.flush()) {
+            return false;
+        }
+    }
+    IndexEntry entry = makeEntry(result, logSize);
+    entries.push_back(entry);
+    logSize += sizeof(length) + length + sizeof(sum);
+
+    fstream index(indexPath, ios::binary | ios::in | ios::out);
+    index.seekp(0, ios::end);
+    index.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+    index.seekp(sizeof(indexMagic));
+    index.write(reinterpret_cast<const char*>(&logSize), sizeof(logSize));
+    return static_cast<bool>(index);
+}
+
+vector<StoredResult> ResultsStore::query(const ResultsQuery& query) const {
+    vector<StoredResult> results;
+    uint64_t hostHash = fnv1a(query.host);
+    uint64_t methodHash = fnv1a(query.method);
+    uint64_t commitHash = fnv1a(query.commit);
+    ifstream log(logPath, ios::binary);
+    for (const IndexEntry& entry : entries) {
+        if ((!query.host.empty() && entry.hostHash != hostHash)
+            || (!query.method.empty() && entry.methodHash != methodHash)
+            || (!query.commit.empty() && entry.commitHash != commitHash)
+            || (query.steps != 0 && entry.steps != query.steps)
+            || (query.threads != 0 && entry.threads != query.threads)
+            || entry.timestamp < query.since) {
+            continue;
+        }
+        StoredResult result;
+        if (readRecord(log, entry.offset, result) == 0) {
+            continue;
+        }
+        // Kolizje skrótów są rozstrzygane przez porównanie pełnych napisów
+        if ((!query.host.empty() && result.host != query.host)
+            || (!query.method.empty() && result.method != query.method)
+            || (!query.commit.empty() && result.commit != query.commit)) {
+            continue;
+        }
+        results.push_back(std::move(result));
+    }
+    return results;
+}
+
+string currentHostName() {
+#ifdef _WIN32
+    char name[MAX_COMPUTERNAME_LENGTH + 1] = {};
+    DWORD size = sizeof(name);
+    if (GetComputerNameA(name, &size)) {
+        return string(name, size);
+    }
+#else
+    char name[256] = {};
+    if (gethostname(name, sizeof(name) - 1) == 0) {
+        return string(name);
+    }
+#endif
+    return "nieznany";
+}
+
+string currentCommit() {
+    return PI_GIT_COMMIT;
+}
+
+int runHistoryMode(int argc, char* argv[]) {
+    string storePath = getOption(argc, argv, "--store", "results.pilog");
+    string importPath = getOption(argc, argv, "--import", "");
+    long long days = getIntOption(argc, argv, "--days", 0);
+
+    // Samo zapytanie nie tworzy ani nie modyfikuje plików magazynu
+    ResultsStore store(storePath, importPath.empty());
+    if (!store.isOpen()) {
+        cerr << "Nie można otworzyć magazynu wyników " << storePath << "." << endl;
+        return 1;
+    }
+
+    long long now = chrono::duration_cast<chrono::seconds>(chrono::system_clock::now().time_since_epoch()).count();
+
+    if (!importPath.empty()) {
+        ifstream input(importPath);
+        if (!input.is_open()) {
+            cerr << "Nie można otworzyć pliku " << importPath << "." << endl;
+            return 1;
+        }
+        StoredResult result;
+        result.timestamp = now;
+        result.host = getOption(argc, argv, "--host", currentHostName());
+        result.method = getOption(argc, argv, "--method", "sweep");
+        result.commit = getOption(argc, argv, "--commit", currentCommit());
+        string line;
+        getline(input, line); // Nagłówek
+        size_t imported = 0;
+        while (getline(input, line)) {
+            istringstream fields(line);
+            char comma = 0;
+            if (fields >> result.steps >> comma >> result.threads >> comma >> result.seconds >> comma >> result.pi) {
+                if (!store.append(result)) {
+                    cerr << "Błąd zapisu do magazynu " << storePath << "." << endl;
+                    return 1;
+                }
+                ++imported;
+            }
+        }
+        cout << "Zaimportowano " << imported << " wyników z " << importPath << " do " << storePath << endl;
+        return 0;
+    }
+
+    ResultsQuery query;
+    query.host = getOption(argc, argv, "--host", "");
+    query.method = getOption(argc, argv, "--method", "");
+    query.commit = getOption(argc, argv, "--commit", "");
+    query.steps = getIntOption(argc, argv, "--steps", 0);
+    query.threads = static_cast<int>(getIntOption(argc, argv, "--threads", 0));
+    query.since = days > 0 ? now - days * 86400 : 0;
+
+    auto startTime = chrono::high_resolution_clock::now();
+    vector<StoredResult> results = store.query(query);
+    chrono::duration<double> duration = chrono::high_resolution_clock::now() - startTime;
+
+    auto print = [](const StoredResult& result) {
+        cout << formatTimestamp(result.timestamp) << ", Host: " << result.host << ", Metoda: " << result.method
+            << ", Commit: " << result.commit << ", Kroki: " << result.steps << ", Wątki: " << result.threads
+            << ", Czas: " << result.seconds << "s, PI: " << result.pi << endl;
+    };
+
+    if (hasFlag(argc, argv, "--all")) {
+        for (const StoredResult& result : results) {
+            print(result);
+        }
+    }
+    else {
+        // Najlepszy (najkrótszy) czas dla każdego komputera
+        map<string, StoredResult> best;
+        for (const StoredResult& result : results) {
+            auto it = best.find(result.host);
+            if (it == best.end() || result.seconds < it->second.seconds) {
+                best[result.host] = result;
+            }
+        }
+        for (const auto& [host, result] : best) {
+            print(result);
+        }
+    }
+    cout << "Pasujące wyniki: " << results.size() << " z " << store.size() << " (zapytanie: " << duration.count() << "s)" << endl;
+    return 0;
+}
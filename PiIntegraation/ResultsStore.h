@@ -0,0 +1,122 @@
+﻿/**
+ * @file ResultsStore.h
+ * @brief Trwały magazyn wyników wszystkich uruchomień z indeksem do szybkich zapytań.
+ *
+ * results.csv jest nadpisywany przy każdym przeglądzie, a magazyn tylko dopisuje.
+ * Dziennik (results.pilog) zawiera rekordy o zmiennej długości z sumą kontrolną;
+ * indeks (results.pilog.idx) ma rekordy stałej długości z kluczami
+ * host / metoda / kroki / wątki / commit, czasem uruchomienia i pozycją rekordu
+ * w dzienniku. Zapytania przeglądają tylko indeks, a z dziennika czytane są
+ * wyłącznie pasujące rekordy. Jeśli indeks nie obejmuje końca dziennika (np. po
+ * przerwaniu programu między zapisami), brakujące wpisy są odtwarzane przy
+ * otwarciu; nieczytelne rekordy są pomijane, a dziennik nigdy nie jest obcinany.
+ *
+ * Zapis i synchronizacja indeksu odbywają się pod wyłączną blokadą pliku
+ * `path.lock` (flock / LockFileEx), więc do jednego magazynu może dopisywać
+ * kilka procesów naraz (np. `history --import` w trakcie przeglądu).
+ *
+ * Liczby zapisywane są w natywnej kolejności bajtów (little-endian na x86/x64).
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Jeden zapisany wynik pomiaru.
+ */
+struct StoredResult {
+    long long timestamp = 0; ///< Czas uruchomienia (sekundy od 1970-01-01 UTC).
+    std::string host;        ///< Nazwa komputera.
+    std::string method;      ///< Tryb lub metoda, np. "sweep".
+    std::string commit;      ///< Wersja programu (PI_GIT_COMMIT).
+    long long steps = 0;
+    int threads = 0;
+    double seconds = 0.0;
+    double pi = 0.0;
+};
+
+/**
+ * @brief Kryteria zapytania; puste napisy i zera oznaczają "dowolna wartość".
+ */
+struct ResultsQuery {
+    std::string host;
+    std::string method;
+    std::string commit;
+    long long steps = 0;
+    int threads = 0;
+    long long since = 0; ///< Tylko wyniki z timestamp >= since.
+};
+
+/**
+ * @brief Dziennik wyników tylko do dopisywania z indeksem w osobnym pliku.
+ *
+ * Obiekt nie jest bezpieczny wątkowo - append() i query() wywołuje jeden wątek
+ * (np. wątek ResultsWriter). Bezpieczeństwo między procesami zapewnia blokada pliku.
+ */
+class ResultsStore {
+public:
+    /**
+     * @brief Otwiera (lub tworzy) dziennik \p path i indeks `path.idx`.
+     * @param readOnly Tylko do zapytań: nie tworzy magazynu i nie zapisuje indeksu ani dziennika.
+     */
+    explicit ResultsStore(const std::string& path, bool readOnly = false);
+
+    /// Czy dziennik został poprawnie otwarty.
+    bool isOpen() const { return open; }
+
+    /// Liczba zapisanych wyników.
+    std::size_t size() const { return entries.size(); }
+
+    /// Dopisuje wynik na rzeczywisty koniec dziennika i do indeksu; false przy błędzie zapisu.
+    bool append(const StoredResult& result);
+
+    /// Wyniki spełniające kryteria, w kolejności zapisu.
+    std::vector<StoredResult> query(const ResultsQuery& query) const;
+
+    /// Wpis indeksu (64 bajty, zapisywany do pliku bez zmian).
+    struct IndexEntry {
+        std::uint64_t hostHash;
+        std::uint64_t methodHash;
+        std::uint64_t commitHash;
+        std::int64_t steps;
+        std::int32_t threads;
+        std::int32_t reserved;
+        std::int64_t timestamp;
+        double seconds;
+        std::uint64_t offset; ///< Pozycja rekordu w dzienniku.
+    };
+
+private:
+    bool synchronizeIndex();
+    bool writeIndex() const;
+
+    std::string logPath;
+    std::string indexPath;
+    std::string lockPath;
+    std::vector<IndexEntry> entries;
+    std::uint64_t logSize = 0;
+    bool readOnly = false;
+    bool open = false;
+};
+
+/// Nazwa bieżącego komputera (lub "nieznany").
+std::string currentHostName();
+
+/// Wersja programu: makro PI_GIT_COMMIT z generowanego przy kompilacji GitCommit.h, domyślnie "unknown".
+std::string currentCommit();
+
+/**
+ * @brief Uruchamia tryb `history` - zapytania o wyniki zgromadzone w magazynie.
+ *
+ * Domyślnie wypisuje najlepszy czas dla każdego komputera; z `--all` wszystkie
+ * pasujące wyniki. Opcje: `--store plik` (domyślnie results.pilog), `--steps n`,
+ * `--threads n`, `--host nazwa`, `--method nazwa`, `--commit id`, `--days n`
+ * (tylko ostatnie n dni), `--import plik.csv` (dopisanie wierszy w formacie
+ * results.csv jako metoda z `--method`, domyślnie "sweep").
+ *
+ * @return Kod zakończenia programu.
+ */
+int runHistoryMode(int argc, char* argv[]);
@@ -0,0 +1,106 @@
+﻿/**
+ * @file ResultsWriter.cpp
+ * @brief Implementacja wątku zapisującego wyniki partiami.
+ */
+
+#include "ResultsWriter.h"
+#include "ResultsStore.h"
+#include "Tracing.h"
+
+#include <chrono>
+#include <iostream>
+#include <ostream>
+#include <sstream>
+
+using namespace std;
+
+ResultsWriter::ResultsWriter(ostream& csv, ostream* console, ResultsStore* store, const string& method, size_t capacity)
+    : csv(csv), console(console), store(store), method(method), queue(capacity) {
+    writer = thread([this] { writerLoop(); });
+}
+
+ResultsWriter::~ResultsWriter() {
+    close();
+}
+
+void ResultsWriter::submit(const SweepRow& row) {
+    while (!queue.tryPush(row)) {
+        {
+            lock_guard<mutex> lock(wakeMutex);
+            drainRequested = true;
+        }
+        wake.notify_one();
+        this_thread::yield();
+    }
+}
+
+void ResultsWriter::close() {
+    if (writer.joinable()) {
+        {
+            lock_guard<mutex> lock(wakeMutex);
+            closing.store(true, memory_order_release);
+        }
+        wake.notify_one();
+        writer.join();
+    }
+}
+
+void ResultsWriter::writerLoop() {
+    ostringstream csvBatch;
+    ostringstream consoleBatch;
+    SweepRow row;
+    StoredResult stored;
+    if (store) {
+        stored.host = currentHostName();
+        stored.method = method;
+        stored.commit = currentCommit();
+    }
+    bool storeFailed = false;
+    for (;;) {
+        long long batchRows = 0;
+        // Odczyt flagi przed opróżnieniem kolejki - po zamknięciu nie zostanie żaden wiersz
+        bool finishing = closing.load(memory_order_acquire);
+        bool any = false;
+        while (queue.tryPop(row)) {
+            any = true;
+            ++batchRows;
+            csvBatch << row.steps << "," << row.threads << "," << row.seconds << "," << row.pi << "\n";
+            if (console) {
+                consoleBatch << "Liczba kroków: " << row.steps << ", Wątki: " << row.threads
+                    << ", Czas: " << row.seconds << "s, PI: " << row.pi << "\n";
+            }
+            if (store && !storeFailed) {
+                stored.timestamp = chrono::duration_cast<chrono::seconds>(chrono::system_clock::now().time_since_epoch()).count();
+                stored.steps = row.steps;
+                stored.threads = row.threads;
+                stored.seconds = row.seconds;
+                stored.pi = row.pi;
+                if (!store->append(stored)) {
+                    storeFailed = true;
+                    cerr << "Błąd zapisu do magazynu wyników - dalsze wiersze trafią tylko do CSV." << endl;
+                }
+            }
+        }
+        if (any) {
+            PI_TRACE1(output_batch, batchRows);
+            csv << csvBatch.str();
+            csv.flush();
+            csvBatch.str("");
+            if (console) {
+                *console << consoleBatch.str();
+                console->flush();
+                consoleBatch.str("");
+            }
+        }
+        if (finishing) {
+            return;
+        }
+        if (!any) {
+            // Bez limitu czasu: wątek budzi tylko pełna kolejka lub close(), więc formatowanie
+            // i opróżnianie buforów nie nakłada się na mierzone obliczenia kolejnej komórki
+            unique_lock<mutex> lock(wakeMutex);
+            wake.wait(lock, [&] { return drainRequested || closing.load(memory_order_relaxed); });
+            drainRequested = false;
+        }
+    }
+}
@@ -0,0 +1,78 @@
+﻿/**
+ * @file ResultsWriter.h
+ * @brief Asynchroniczny zapis wyników przeglądu poza ścieżką pomiaru czasu.
+ *
+ * Pętla pomiarowa tylko wstawia wiersz do kolejki SpscQueue (bez blokad
+ * i wywołań systemowych). Wątek zapisujący śpi, dopóki kolejka się nie
+ * zapełni albo nie zostanie wywołane close(), i dopiero wtedy formatuje całą
+ * partię i zapisuje ją do pliku CSV oraz na konsolę - operacje wejścia-wyjścia
+ * nie nakładają się więc na mierzone obliczenia. Postęp przeglądu w trakcie
+ * pomiarów pokazuje tryb `live` (LiveResults.h). Opcjonalnie wiersze są też
+ * dopisywane do trwałego magazynu wyników (ResultsStore.h).
+ */
+
+#pragma once
+
+#include "SpscQueue.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <iosfwd>
+#include <mutex>
+#include <string>
+#include <thread>
+
+class ResultsStore;
+
+/**
+ * @brief Jeden wiersz wyników przeglądu (komórka: kroki × wątki).
+ */
+struct SweepRow {
+    long long steps = 0;
+    int threads = 0;
+    double seconds = 0.0;
+    double pi = 0.0;
+};
+
+/**
+ * @brief Wątek zapisujący wiersze przeglądu do pliku CSV, na konsolę i do magazynu wyników.
+ *
+ * submit() może wywoływać tylko jeden wątek (producent kolejki SPSC).
+ * Destruktor wywołuje close().
+ */
+class ResultsWriter {
+public:
+    /**
+     * @param csv Strumień pliku CSV (nagłówek zapisuje wywołujący).
+     * @param console Strumień konsoli lub nullptr.
+     * @param store Magazyn wyników lub nullptr; używa go wyłącznie wątek zapisujący.
+     * @param method Nazwa metody zapisywana w magazynie.
+     * @param capacity Pojemność kolejki w wierszach.
+     */
+    ResultsWriter(std::ostream& csv, std::ostream* console, ResultsStore* store = nullptr,
+        const std::string& method = "sweep", std::size_t capacity = 4096);
+    ~ResultsWriter();
+
+    ResultsWriter(const ResultsWriter&) = delete;
+    ResultsWriter& operator=(const ResultsWriter&) = delete;
+
+    /// Przekazuje wiersz do zapisu; tylko przy pełnej kolejce budzi wątek zapisujący i czeka.
+    void submit(const SweepRow& row);
+
+    /// Zapisuje pozostałe wiersze i kończy wątek zapisujący.
+    void close();
+
+private:
+    void writerLoop();
+
+    std::ostream& csv;
+    std::ostream* console;
+    ResultsStore* store;
+    std::string method;
+    SpscQueue<SweepRow> queue;
+    std::atomic<bool> closing{ false };
+    std::mutex wakeMutex;
+    bool drainRequested = false;  ///< Kolejka jest pełna (chronione przez wakeMutex).
+    std::condition_variable wake; ///< Budzi uśpiony wątek zapisujący (pełna kolejka, zamknięcie).
+    std::thread writer;
+};
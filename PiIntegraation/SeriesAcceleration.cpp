@@ -0,0 +1,352 @@
+﻿/**
+ * @file SeriesAcceleration.cpp
+ * @brief Implementacja szeregów dla PI, ich równoległego sumowania i metod przyspieszania zbieżności.
+ */
+
+#include "SeriesAcceleration.h"
+#include "CommandLine.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+
+using namespace std;
+
+namespace {
+
+constexpr double referencePi = 3.14159265358979323846;
+
+double leibnizTerm(long long k) {
+    return (k % 2 == 0 ? 4.0 : -4.0) / (2.0 * static_cast<double>(k) + 1.0);
+}
+
+double wallisFactor(long long k) {
+    double n = static_cast<double>(k + 1);
+    return 4.0 * n * n / (4.0 * n * n - 1.0);
+}
+
+/**
+ * @brief Suma lub iloczyn wyrazów o numerach z przedziału [from, to).
+ *
+ * Suma liczona jest z kompensacją Kahana, aby przy miliardach wyrazów błąd
+ * zaokrągleń nie zasłonił błędu samego szeregu.
+ */
+double rangeValue(const PiSeries& series, long long from, long long to) {
+    if (series.product) {
+        double product = 1.0;
+        for (long long k = from; k < to; ++k) {
+            product *= series.term(k);
+        }
+        return product;
+    }
+    double sum = 0.0;
+    double compensation = 0.0;
+    for (long long k = from; k < to; ++k) {
+        double value = series.term(k) - compensation;
+        double updated = sum + value;
+        compensation = (updated - sum) - value;
+        sum = updated;
+    }
+    return sum;
+}
+
+double combine(const PiSeries& series, double left, double right) {
+    return series.product ? left * right : left + right;
+}
+
+double neutralValue(const PiSeries& series) {
+    return series.product ? 1.0 : 0.0;
+}
+
+/**
+ * @brief Wynik zwykłego (nieprzyspieszonego) sumowania.
+ */
+struct PlainResult {
+    long long terms = 0;
+    double estimate = 0.0;
+    bool reached = false;
+};
+
+/**
+ * @brief Szuka najmniejszej liczby wyrazów, dla której błąd jest mniejszy od \p tolerance.
+ *
+ * Liczba wyrazów jest podwajana (każdy nowy przedział sumowany równolegle),
+ * a następnie przedział, w którym nastąpiło przejście, jest zawężany przez
+ * równoległe sumowanie jego fragmentów. Korzysta z tego, że błąd obu szeregów
+ * maleje monotonicznie.
+ */
+PlainResult plainSummation(const PiSeries& series, double tolerance, long long maxTerms, ThreadPool& pool) {
+    int chunks = static_cast<int>(pool.size()) * 8;
+    vector<double> chunkValues(chunks);
+    vector<long long> chunkEnds(chunks);
+
+    // Agregaty fragmentów wyrazów [from, to) liczone równolegle, razem z końcami fragmentów
+    auto parallelRange = [&](long long from, long long to) {
+        int used = static_cast<int>(min<long long>(chunks, to - from));
+        pool.parallelFor(to - from, used, [&](long long begin, long long end, int chunk) {
+            chunkValues[chunk] = rangeValue(series, from + begin, from + end);
+            chunkEnds[chunk] = from + end;
+        });
+        return used;
+    };
+
+    auto error = [&](double value) { return fabs(series.scale * value - referencePi); };
+
+    PlainResult result;
+    long long low = 0;
+    double lowValue = neutralValue(series);
+    long long high = 1;
+    double highValue = rangeValue(series, 0, 1);
+    while (error(highValue) >= tolerance) {
+        if (high >= maxTerms) {
+            result.terms = high;
+            result.estimate = series.scale * highValue;
+            return result;
+        }
+        long long next = min(2 * high, maxTerms);
+        int used = parallelRange(high, next);
+        double value = highValue;
+        for (int i = 0; i < used; ++i) {
+            value = combine(series, value, chunkValues[i]);
+        }
+        low = high;
+        lowValue = highValue;
+        high = next;
+        highValue = value;
+    }
+
+    // Zawężanie: błąd po low wyrazach >= tolerancja, po high wyrazach < tolerancja
+    while (high - low > 1) {
+        int used = parallelRange(low, high - 1);
+        double value = lowValue;
+        for (int i = 0; i < used; ++i) {
+            value = combine(series, value, chunkValues[i]);
+            if (error(value) < tolerance) {
+                high = chunkEnds[i];
+                highValue = value;
+                break;
+            }
+            low = chunkEnds[i];
+            lowValue = value;
+        }
+    }
+
+    result.terms = high;
+    result.estimate = series.scale * highValue;
+    result.reached = true;
+    return result;
+}
+
+} // namespace
+
+PiSeries leibnizSeries() {
+    PiSeries series;
+    series.name = "Leibniz";
+    series.alternating = true;
+    series.term = leibnizTerm;
+    return series;
+}
+
+PiSeries wallisSeries() {
+    PiSeries series;
+    series.name = "Wallis";
+    series.product = true;
+    series.scale = 2.0;
+    series.term = wallisFactor;
+    return series;
+}
+
+vector<double> partialSums(const PiSeries& series, long long count, ThreadPool& pool) {
+    vector<double> sums(static_cast<size_t>(max(0LL, count)));
+    if (count <= 0) {
+        return sums;
+    }
+    int chunks = static_cast<int>(min<long long>(count, pool.size()));
+
+    // Przebieg 1: agregat każdego fragmentu
+    vector<double> chunkValues(chunks);
+    pool.parallelFor(count, chunks, [&](long long begin, long long end, int chunk) {
+        chunkValues[chunk] = rangeValue(series, begin, end);
+    });
+
+    // Skan wyłączny agregatów fragmentów
+    vector<double> offsets(chunks, neutralValue(series));
+    for (int i = 1; i < chunks; ++i) {
+        offsets[i] = combine(series, offsets[i - 1], chunkValues[i - 1]);
+    }
+
+    // Przebieg 2: lokalne przybliżenia z przesunięciem fragmentu
+    pool.parallelFor(count, chunks, [&](long long begin, long long end, int chunk) {
+        double value = offsets[chunk];
+        for (long long k = begin; k < end; ++k) {
+            value = combine(series, value, series.term(k));
+            sums[k] = series.scale * value;
+        }
+    });
+    return sums;
+}
+
+double eulerTransform(const vector<double>& sums, size_t n) {
+    // Wielokrotne uśrednianie sąsiednich sum częściowych (transformacja Eulera dla szeregów naprzemiennych)
+    vector<double> values(sums.begin(), sums.begin() + n);
+    for (size_t size = n; size > 1; --size) {
+        for (size_t i = 0; i + 1 < size; ++i) {
+            values[i] = 0.5 * (values[i] + values[i + 1]);
+        }
+    }
+    return values[0];
+}
+
+double aitkenTransform(const vector<double>& sums, size_t n) {
+    // Iterowany proces Δ² Aitkena - każda iteracja skraca ciąg o dwa elementy
+    vector<double> values(sums.begin(), sums.begin() + n);
+    while (values.size() >= 3) {
+        vector<double> next(values.size() - 2);
+        for (size_t i = 0; i < next.size(); ++i) {
+            double d1 = values[i + 1] - values[i];
+            double d2 = values[i + 2] - values[i + 1];
+            double denominator = d2 - d1;
+            next[i] = denominator != 0.0 ? values[i + 2] - d2 * d2 / denominator : values[i + 2];
+        }
+        values.swap(next);
+    }
+    return values.back();
+}
+
+double wynnEpsilon(const vector<double>& sums, size_t n) {
+    // Tablica epsilon: kolumny parzyste zawierają kolejne przybliżenia granicy
+    vector<double> previous(n + 1, 0.0);
+    vector<double> current(sums.begin(), sums.begin() + n);
+    double best = sums[n - 1];
+    for (size_t column = 1; current.size() > 1; ++column) {
+        vector<double> next(current.size() - 1);
+        for (size_t j = 0; j < next.size(); ++j) {
+            double difference = current[j + 1] - current[j];
+            if (difference == 0.0) {
+                return current[j + 1]; // Ciąg ustalony - dalsze kolumny są nieokreślone
+            }
+            next[j] = previous[j + 1] + 1.0 / difference;
+        }
+        if (column % 2 == 0) {
+            best = next.back();
+        }
+        previous.swap(current);
+        current.swap(next);
+    }
+    return best;
+}
+
+double levinTransform(const vector<double>& sums, size_t n) {
+    // Transformacja u Levina z β = 1: ω_j = (j + 1) a_j, gdzie a_j = S_j − S_{j−1}
+    if (n < 2) {
+        return sums[n - 1];
+    }
+    size_t k = n - 1;
+    double numerator = 0.0;
+    double denominator = 0.0;
+    double binomial = 1.0;
+    for (size_t j = 0; j <= k; ++j) {
+        double term = j == 0 ? sums[0] : sums[j] - sums[j - 1];
+        double omega = (static_cast<double>(j) + 1.0) * term;
+        if (omega == 0.0) {
+            return sums[j];
+        }
+        double weight = binomial * pow((1.0 + j) / (1.0 + k), static_cast<double>(k) - 1.0) / omega;
+        if (j % 2 == 1) {
+            weight = -weight;
+        }
+        numerator += weight * sums[j];
+        denominator += weight;
+        binomial = binomial * static_cast<double>(k - j) / static_cast<double>(j + 1);
+    }
+    return numerator / denominator;
+}
+
+int runSeriesMode(int argc, char* argv[]) {
+    string seriesName = getOption(argc, argv, "--series", "leibniz");
+    double tolerance = getDoubleOption(argc, argv, "--tolerance", 1e-10);
+    long long maxTerms = max(1LL, getIntOption(argc, argv, "--max-terms", 4000000000LL));
+    int numThreads = static_cast<int>(getIntOption(argc, argv, "--threads", thread::hardware_concurrency()));
+    const size_t maxAcceleratedTerms = 100;
+
+    PiSeries series;
+    if (seriesName == "leibniz") {
+        series = leibnizSeries();
+    }
+    else if (seriesName == "wallis") {
+        series = wallisSeries();
+    }
+    else {
+        cerr << "Nieznany szereg: " << seriesName << endl;
+        return 1;
+    }
+
+    ThreadPool pool(static_cast<unsigned>(max(1, numThreads)));
+    cout << "Szereg: " << series.name << ", Tolerancja: " << tolerance << ", Wątki: " << pool.size() << endl;
+
+    auto report = [&](const string& method, long long terms, bool reached, double seconds, double estimate) {
+        cout << "Metoda: " << method << ", Wyrazy: ";
+        if (reached) {
+            cout << terms;
+        }
+        else {
+            cout << "nie osiągnięto (" << terms << ")";
+        }
+        cout << ", Czas: " << seconds << "s, PI: " << setprecision(15) << estimate
+            << ", Błąd: " << setprecision(3) << fabs(estimate - referencePi) << setprecision(6) << endl;
+    };
+
+    // Zwykłe sumowanie - równoległe sumowanie miliardów wyrazów
+    {
+        auto startTime = chrono::high_resolution_clock::now();
+        PlainResult plain = plainSummation(series, tolerance, maxTerms, pool);
+        chrono::duration<double> duration = chrono::high_resolution_clock::now() - startTime;
+        report("bez przyspieszania", plain.terms, plain.reached, duration.count(), plain.estimate);
+    }
+
+    // Metody przyspieszania - najmniejsza liczba przybliżeń S_0..S_{n-1} dająca zadaną dokładność
+    struct Method {
+        string name;
+        double (*transform)(const vector<double>&, size_t);
+        bool alternatingOnly;
+    };
+    Method methods[] = {
+        { "Euler", eulerTransform, true },
+        { "Aitken", aitkenTransform, false },
+        { "Wynn epsilon", wynnEpsilon, false },
+        { "Levin u", levinTransform, false },
+    };
+    for (const Method& method : methods) {
+        if (method.alternatingOnly && !series.alternating) {
+            cout << "Metoda: " << method.name << " - nie dotyczy (szereg nie jest naprzemienny)" << endl;
+            continue;
+        }
+        auto startTime = chrono::high_resolution_clock::now();
+        vector<double> sums = partialSums(series, maxAcceleratedTerms, pool);
+        size_t terms = 1;
+        double estimate = sums[0];
+        double bestError = fabs(estimate - referencePi);
+        double bestEstimate = estimate;
+        size_t bestTerms = 1;
+        for (; terms <= sums.size(); ++terms) {
+            estimate = method.transform(sums, terms);
+            double error = fabs(estimate - referencePi);
+            if (error < bestError) {
+                bestError = error;
+                bestEstimate = estimate;
+                bestTerms = terms;
+            }
+            if (error < tolerance) {
+                break;
+            }
+        }
+        chrono::duration<double> duration = chrono::high_resolution_clock::now() - startTime;
+        bool reached = terms <= sums.size();
+        report(method.name, static_cast<long long>(reached ? terms : bestTerms), reached, duration.count(),
+            reached ? estimate : bestEstimate);
+    }
+    return 0;
+}
@@ -0,0 +1,65 @@
+﻿/**
+ * @file SeriesAcceleration.h
+ * @brief Szeregi dla liczby PI (Leibniz, Wallis) i metody przyspieszania ich zbieżności.
+ *
+ * Szereg Leibniza i iloczyn Wallisa to klasyczne, szkolne odpowiedniki całki
+ * z PiIntegraation.cpp, ale zbiegają bardzo wolno (błąd rzędu 1/n). Metody
+ * przyspieszania zbieżności (Euler, Aitken Δ², epsilon Wynna, transformacja
+ * Levina) pozwalają uzyskać tę samą dokładność z kilkudziesięciu wyrazów.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+class ThreadPool;
+
+/**
+ * @brief Opis szeregu (lub iloczynu) zbieżnego do liczby PI.
+ */
+struct PiSeries {
+    std::string name;        ///< Nazwa wyświetlana w raporcie.
+    bool product = false;    ///< true dla iloczynu nieskończonego, false dla sumy.
+    bool alternating = false;///< Czy wyrazy mają naprzemienne znaki (warunek transformacji Eulera).
+    double scale = 1.0;      ///< Mnożnik wyniku (np. 2 dla iloczynu Wallisa).
+    double (*term)(long long k) = nullptr; ///< k-ty wyraz sumy lub czynnik iloczynu (k od 0).
+};
+
+/// Szereg Leibniza: \( \pi = 4 \sum_{k \ge 0} \frac{(-1)^k}{2k+1} \).
+PiSeries leibnizSeries();
+
+/// Iloczyn Wallisa: \( \pi = 2 \prod_{k \ge 1} \frac{4k^2}{4k^2 - 1} \).
+PiSeries wallisSeries();
+
+/**
+ * @brief Równolegle wyznacza kolejne przybliżenia \( S_0, \dots, S_{count-1} \) (już przemnożone przez scale).
+ *
+ * Fragmenty wyrazów są sumowane (lub mnożone) równolegle, a następnie łączone
+ * skanem, tak jak w trybie `cumulative`.
+ */
+std::vector<double> partialSums(const PiSeries& series, long long count, ThreadPool& pool);
+
+/**
+ * @brief Przyspieszanie zbieżności ciągu przybliżeń.
+ *
+ * Każda funkcja przyjmuje ciąg przybliżeń \( S_0, \dots, S_{n-1} \) i zwraca
+ * jedno, dokładniejsze oszacowanie granicy.
+ */
+double eulerTransform(const std::vector<double>& sums, std::size_t n);
+double aitkenTransform(const std::vector<double>& sums, std::size_t n);
+double wynnEpsilon(const std::vector<double>& sums, std::size_t n);
+double levinTransform(const std::vector<double>& sums, std::size_t n);
+
+/**
+ * @brief Uruchamia tryb `series`.
+ *
+ * Opcje: `--series leibniz|wallis`, `--tolerance x` (domyślnie 1e-10),
+ * `--max-terms n` (limit wyrazów dla zwykłego sumowania), `--threads n`.
+ * Dla każdej metody wypisuje liczbę wyrazów potrzebną do osiągnięcia
+ * zadanej dokładności oraz czas obliczeń.
+ *
+ * @return Kod zakończenia programu.
+ */
+int runSeriesMode(int argc, char* argv[]);
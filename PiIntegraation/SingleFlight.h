@@ -0,0 +1,96 @@
+﻿/**
+ * @file SingleFlight.h
+ * @brief Łączenie jednoczesnych identycznych żądań w jedno obliczenie (single-flight).
+ *
+ * Pierwsze żądanie dla danego klucza (lider) uruchamia obliczenie, a kolejne
+ * żądania z tym samym kluczem, zgłoszone zanim się zakończy, dostają ten sam
+ * std::shared_future. Zakończone obliczenia nie są pamiętane - żądanie
+ * zgłoszone po zakończeniu uruchamia nowe obliczenie, więc to nie jest pamięć
+ * podręczna wyników, tylko deduplikacja obliczeń "w locie".
+ */
+
+#pragma once
+
+#include <chrono>
+#include <future>
+#include <map>
+#include <mutex>
+#include <utility>
+
+/**
+ * @brief Liczniki żądań obsłużonych przez SingleFlight.
+ */
+struct SingleFlightMetrics {
+    long long requests = 0;   ///< Wszystkie żądania.
+    long long executions = 0; ///< Uruchomione obliczenia (żądania liderów).
+    long long coalesced = 0;  ///< Żądania dołączone do trwającego obliczenia.
+};
+
+/**
+ * @brief Mapa obliczeń w toku indeksowana kluczem żądania.
+ * @tparam Key Klucz żądania (z operatorem <).
+ * @tparam Value Typ wyniku.
+ */
+template <typename Key, typename Value>
+class SingleFlight {
+public:
+    /**
+     * @brief Zwraca wynik trwającego obliczenia dla \p key lub uruchamia nowe.
+     *
+     * Lider wstawia pod blokadą mapy przyszłość nowej obietnicy wyniku, zwalnia
+     * blokadę i dopiero wtedy przekazuje obietnicę do \p start. Wywołanie nie
+     * czeka na obliczenie - ani dla lidera, ani dla dołączających żądań.
+     *
+     * @param start Funkcja przyjmująca std::promise<Value>, która zleca obliczenie
+     *              spełniające tę obietnicę (np. IntegrationScheduler::submit());
+     *              wywoływana tylko dla lidera. Jeśli \p start zgłosi wyjątek,
+     *              niespełniona obietnica kończy oczekujących błędem broken_promise.
+     * @param joined Ustawiane na true, jeśli żądanie dołączyło do trwającego obliczenia.
+     */
+    template <typename Start>
+    std::shared_future<Value> run(const Key& key, Start&& start, bool* joined = nullptr) {
+        std::promise<Value> outcome;
+        std::shared_future<Value> result = outcome.get_future().share();
+        {
+            std::lock_guard<std::mutex> lock(flightsMutex);
+            ++counters.requests;
+            auto it = flights.find(key);
+            if (it != flights.end() && !isReady(it->second)) {
+                ++counters.coalesced;
+                if (joined) {
+                    *joined = true;
+                }
+                return it->second;
+            }
+
+            // Zakończone obliczenia są usuwane leniwie - mapa zawiera tylko obliczenia w toku
+            for (auto flight = flights.begin(); flight != flights.end();) {
+                flight = isReady(flight->second) ? flights.erase(flight) : std::next(flight);
+            }
+            ++counters.executions;
+            if (joined) {
+                *joined = false;
+            }
+            flights[key] = result;
+        }
+
+        // Poza blokadą - start() może blokować lub wykonywać zadania puli
+        start(std::move(outcome));
+        return result;
+    }
+
+    /// Bieżące wartości liczników.
+    SingleFlightMetrics metrics() {
+        std::lock_guard<std::mutex> lock(flightsMutex);
+        return counters;
+    }
+
+private:
+    static bool isReady(const std::shared_future<Value>& result) {
+        return result.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }
+
+    std::mutex flightsMutex;
+    std::map<Key, std::shared_future<Value>> flights;
+    SingleFlightMetrics counters;
+};
@@ -0,0 +1,77 @@
+﻿/**
+ * @file SpscQueue.h
+ * @brief Bezblokadowa kolejka jeden producent - jeden konsument.
+ *
+ * Bufor cykliczny o pojemności będącej potęgą dwójki. Producent zapisuje tylko
+ * indeks końca, konsument tylko indeks początku, więc żadna operacja nie bierze
+ * blokady ani nie wywołuje systemu - w odróżnieniu od BoundedQueue nadaje się
+ * do wywołań między pomiarami czasu.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Kolejka FIFO dla dokładnie jednego wątku producenta i jednego konsumenta.
+ * @tparam T Typ elementów (przenoszonych, nie kopiowanych).
+ */
+template <typename T>
+class SpscQueue {
+public:
+    /// Tworzy kolejkę mieszczącą co najmniej \p capacity elementów.
+    explicit SpscQueue(std::size_t capacity) {
+        std::size_t size = 2;
+        while (size < capacity) {
+            size *= 2;
+        }
+        slots.resize(size);
+        mask = size - 1;
+    }
+
+    /**
+     * @brief Wstawia element bez czekania (wywołuje tylko producent).
+     * @return false, jeśli kolejka jest pełna.
+     */
+    bool tryPush(T item) {
+        std::size_t tail = tailIndex.load(std::memory_order_relaxed);
+        if (tail - cachedHead > mask) {
+            cachedHead = headIndex.load(std::memory_order_acquire);
+            if (tail - cachedHead > mask) {
+                return false;
+            }
+        }
+        slots[tail & mask] = std::move(item);
+        tailIndex.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Pobiera element bez czekania (wywołuje tylko konsument).
+     * @return false, jeśli kolejka jest pusta.
+     */
+    bool tryPop(T& item) {
+        std::size_t head = headIndex.load(std::memory_order_relaxed);
+        if (head == cachedTail) {
+            cachedTail = tailIndex.load(std::memory_order_acquire);
+            if (head == cachedTail) {
+                return false;
+            }
+        }
+        item = std::move(slots[head & mask]);
+        headIndex.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    std::vector<T> slots;
+    std::size_t mask = 0;
+    // Indeksy rosną bez ograniczeń; osobne linie pamięci podręcznej zapobiegają fałszywemu współdzieleniu
+    alignas(64) std::atomic<std::size_t> headIndex{ 0 };
+    alignas(64) std::size_t cachedTail = 0; ///< Kopia tailIndex konsumenta.
+    alignas(64) std::atomic<std::size_t> tailIndex{ 0 };
+    alignas(64) std::size_t cachedHead = 0; ///< Kopia headIndex producenta.
+};
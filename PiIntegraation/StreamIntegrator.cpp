@@ -0,0 +1,313 @@
+﻿/**
+ * @file StreamIntegrator.cpp
+ * @brief Implementacja trybu strumieniowego: czytnik z podwójnym buforowaniem,
+ *        parsowanie danych binarnych i tekstowych oraz bieżąca całka.
+ */
+
+#include "StreamIntegrator.h"
+#include "CommandLine.h"
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#endif
+
+using namespace std;
+
+RunningIntegral::RunningIntegral(double dt) : dt(dt) {
+}
+
+void RunningIntegral::add(const double* samples, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        add(samples[i]);
+    }
+}
+
+void RunningIntegral::add(double sample) {
+    if (count > 0) {
+        // Pole trapezu między poprzednią a bieżącą próbką, sumowane z kompensacją Kahana
+        double area = (previous + sample) * 0.5 * dt - compensation;
+        double updated = sum + area;
+        compensation = (updated - sum) - area;
+        sum = updated;
+    }
+    previous = sample;
+    ++count;
+}
+
+double RunningIntegral::value() const {
+    return sum;
+}
+
+DoubleBufferedReader::DoubleBufferedReader(FILE* input, size_t bufferBytes) : input(input) {
+    size_t doubles = max<size_t>(1, bufferBytes / sizeof(double));
+    storage[0].resize(doubles);
+    storage[1].resize(doubles);
+    reader = thread(&DoubleBufferedReader::readLoop, this);
+}
+
+DoubleBufferedReader::~DoubleBufferedReader() {
+    {
+        lock_guard<mutex> lock(bufferMutex);
+        current = -1;
+        stopping = true;
+    }
+    changed.notify_all();
+    reader.join();
+}
+
+void DoubleBufferedReader::readLoop() {
+    for (int index = 0;; index ^= 1) {
+        {
+            unique_lock<mutex> lock(bufferMutex);
+            changed.wait(lock, [&] { return stopping || (!ready[index] && current != index); });
+            if (stopping) {
+                return;
+            }
+        }
+
+        // Wypełnianie całego bufora - tylko ostatni bufor strumienia może być niepełny
+        char* data = reinterpret_cast<char*>(storage[index].data());
+        size_t capacity = storage[index].size() * sizeof(double);
+        size_t total = 0;
+        while (total < capacity) {
+            size_t count = fread(data + total, 1, capacity - total, input);
+            if (count == 0) {
+                break;
+            }
+            total += count;
+        }
+
+        {
+            lock_guard<mutex> lock(bufferMutex);
+            filled[index] = total;
+            ready[index] = total > 0;
+            finished = total < capacity;
+        }
+        changed.notify_all();
+        if (total < capacity) {
+            return;
+        }
+    }
+}
+
+const char* DoubleBufferedReader::next(size_t& size) {
+    unique_lock<mutex> lock(bufferMutex);
+    if (current >= 0) {
+        // Zwolnienie poprzedniego bufora, aby wątek czytający mógł go ponownie wypełnić
+        ready[current] = false;
+        current = -1;
+        changed.notify_all();
+    }
+
+    changed.wait(lock, [&] { return ready[expected] || finished; });
+    if (!ready[expected]) {
+        size = 0;
+        return nullptr;
+    }
+    current = expected;
+    expected ^= 1;
+    size = filled[current];
+    return reinterpret_cast<const char*>(storage[current].data());
+}
+
+namespace {
+
+/**
+ * @brief Wypisuje wynik częściowy co \p interval próbek.
+ */
+struct ProgressReporter {
+    long long interval;
+    long long nextReport;
+
+    explicit ProgressReporter(long long interval) : interval(interval), nextReport(interval) {
+    }
+
+    /// Ile próbek można jeszcze dodać przed kolejnym raportem.
+    long long remaining(const RunningIntegral& integral) const {
+        return nextReport - integral.samples();
+    }
+
+    void check(const RunningIntegral& integral) {
+        if (integral.samples() >= nextReport) {
+            cout << "Próbki: " << integral.samples() << ", Całka: " << integral.value() << "\n";
+            nextReport += interval;
+        }
+    }
+};
+
+/**
+ * @brief Parser próbek w formacie tekstowym (CSV lub jedna liczba w wierszu).
+ *
+ * Liczby są konwertowane przez std::from_chars bezpośrednio z bufora wejściowego.
+ * Token przecięty granicą bufora jest przechowywany w krótkim buforze \p tail
+ * i dokończony po nadejściu kolejnego bloku danych.
+ */
+class TextSampleParser {
+public:
+    TextSampleParser(int column, RunningIntegral& integral, ProgressReporter& reporter)
+        : column(column), integral(integral), reporter(reporter) {
+    }
+
+    void parse(const char* data, size_t size) {
+        size_t pos = 0;
+        if (!tail.empty()) {
+            size_t end = tokenEnd(data, 0, size);
+            tail.append(data, end);
+            if (tail.size() > maxTokenLength) {
+                tail.resize(maxTokenLength + 1); // Za długi token i tak zostanie odrzucony
+            }
+            if (end == size) {
+                return; // Token nadal niekompletny
+            }
+            consume(tail.data(), tail.data() + tail.size());
+            tail.clear();
+            pos = end;
+        }
+
+        while (pos < size) {
+            char c = data[pos];
+            if (c == '\n') {
+                field = 0;
+                ++pos;
+            }
+            else if (c == ',' || c == ';' || c == '\t') {
+                ++field;
+                ++pos;
+            }
+            else if (c == ' ' || c == '\r') {
+                ++pos;
+            }
+            else {
+                size_t end = tokenEnd(data, pos, size);
+                if (end == size) {
+                    tail.assign(data + pos, size - pos);
+                    return;
+                }
+                consume(data + pos, data + end);
+                pos = end;
+            }
+        }
+    }
+
+    void finish() {
+        if (!tail.empty()) {
+            consume(tail.data(), tail.data() + tail.size());
+            tail.clear();
+        }
+    }
+
+    long long skipped() const { return skippedTokens; }
+
+private:
+    static constexpr size_t maxTokenLength = 256; ///< Dłuższe tokeny są odrzucane.
+
+    static size_t tokenEnd(const char* data, size_t pos, size_t size) {
+        while (pos < size) {
+            char c = data[pos];
+            if (c == '\n' || c == '\r' || c == ',' || c == ';' || c == '\t' || c == ' ') {
+                break;
+            }
+            ++pos;
+        }
+        return pos;
+    }
+
+    void consume(const char* begin, const char* end) {
+        if (field != column) {
+            return;
+        }
+        double value = 0.0;
+        auto [ptr, ec] = from_chars(begin, end, value);
+        if (ec != errc() || ptr != end || end - begin > static_cast<ptrdiff_t>(maxTokenLength)) {
+            ++skippedTokens; // Np. nagłówek CSV
+            return;
+        }
+        integral.add(value);
+        reporter.check(integral);
+    }
+
+    int column;
+    int field = 0;
+    string tail;
+    long long skippedTokens = 0;
+    RunningIntegral& integral;
+    ProgressReporter& reporter;
+};
+
+} // namespace
+
+int runStreamMode(int argc, char* argv[]) {
+    string inputPath = getOption(argc, argv, "--input", "");
+    bool binary = hasFlag(argc, argv, "--binary");
+    int column = static_cast<int>(getIntOption(argc, argv, "--column", 0));
+    double dt = getDoubleOption(argc, argv, "--dt", 1.0);
+    long long reportEvery = max(1LL, getIntOption(argc, argv, "--report", 1000000));
+    size_t bufferBytes = static_cast<size_t>(getIntOption(argc, argv, "--buffer", 1 << 22));
+
+    FILE* input = stdin;
+    if (!inputPath.empty()) {
+        input = fopen(inputPath.c_str(), binary ? "rb" : "r");
+        if (input == nullptr) {
+            cerr << "Nie można otworzyć pliku " << inputPath << " do odczytu." << endl;
+            return 1;
+        }
+    }
+#ifdef _WIN32
+    else if (binary) {
+        _setmode(_fileno(stdin), _O_BINARY);
+    }
+#endif
+
+    RunningIntegral integral(dt);
+    ProgressReporter reporter(reportEvery);
+    TextSampleParser parser(column, integral, reporter);
+    size_t trailingBytes = 0;
+
+    auto startTime = chrono::high_resolution_clock::now();
+    {
+        DoubleBufferedReader reader(input, bufferBytes);
+        size_t size = 0;
+        while (const char* data = reader.next(size)) {
+            if (!binary) {
+                parser.parse(data, size);
+                continue;
+            }
+
+            // Bufor jest wyrównany do double, więc dane binarne są używane bez kopiowania
+            const double* samples = reinterpret_cast<const double*>(data);
+            size_t count = size / sizeof(double);
+            trailingBytes = size % sizeof(double);
+            while (count > 0) {
+                size_t take = static_cast<size_t>(min<long long>(static_cast<long long>(count), reporter.remaining(integral)));
+                integral.add(samples, take);
+                reporter.check(integral);
+                samples += take;
+                count -= take;
+            }
+        }
+    }
+    parser.finish();
+    auto endTime = chrono::high_resolution_clock::now();
+    chrono::duration<double> duration = endTime - startTime;
+
+    if (input != stdin) {
+        fclose(input);
+    }
+    if (trailingBytes != 0) {
+        cerr << "Pominięto " << trailingBytes << " bajtów niepełnej próbki na końcu strumienia." << endl;
+    }
+    if (parser.skipped() != 0) {
+        cerr << "Pominięto " << parser.skipped() << " niepoprawnych wartości." << endl;
+    }
+
+    cout << "Próbki: " << integral.samples() << ", Całka: " << integral.value()
+        << ", Czas: " << duration.count() << "s" << endl;
+    return 0;
+}
@@ -0,0 +1,119 @@
+﻿/**
+ * @file StreamIntegrator.h
+ * @brief Całkowanie strumienia próbek czytanego ze standardowego wejścia lub potoku.
+ *
+ * Tryb strumieniowy pozwala całkować dane, które nie mieszczą się w pamięci
+ * (np. odczyty czujników). Próbki są czytane dużymi blokami przez osobny wątek
+ * (podwójne buforowanie), a całka jest aktualizowana na bieżąco przy stałym
+ * zużyciu pamięci. Co zadaną liczbę próbek wypisywany jest wynik częściowy.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdio>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Bieżący stan całki liczonej metodą trapezów ze stałym krokiem.
+ *
+ * Próbki są traktowane jako wartości funkcji w punktach odległych o \p dt.
+ * Suma jest prowadzona z kompensacją Kahana, więc błąd zaokrągleń nie rośnie
+ * wraz z długością strumienia.
+ */
+class RunningIntegral {
+public:
+    /**
+     * @brief Tworzy pustą całkę.
+     * @param dt Odstęp między kolejnymi próbkami.
+     */
+    explicit RunningIntegral(double dt);
+
+    /**
+     * @brief Dodaje kolejne próbki do całki.
+     * @param samples Wskaźnik na ciągłą tablicę próbek.
+     * @param count Liczba próbek w tablicy.
+     */
+    void add(const double* samples, std::size_t count);
+
+    /// Dodaje pojedynczą próbkę.
+    void add(double sample);
+
+    /// Zwraca wartość całki od pierwszej do ostatniej przyjętej próbki.
+    double value() const;
+
+    /// Zwraca liczbę przyjętych próbek.
+    long long samples() const { return count; }
+
+private:
+    double dt;                 ///< Odstęp między próbkami.
+    double sum = 0.0;          ///< Suma pól trapezów.
+    double compensation = 0.0; ///< Poprawka Kahana do sumy.
+    double previous = 0.0;     ///< Ostatnia przyjęta próbka.
+    long long count = 0;       ///< Liczba przyjętych próbek.
+};
+
+/**
+ * @brief Czytnik z podwójnym buforowaniem.
+ *
+ * Wątek czytający wypełnia jeden bufor, podczas gdy wątek główny przetwarza
+ * drugi. Pamięć jest ograniczona do dwóch buforów niezależnie od długości
+ * strumienia. Bufory są wyrównane do rozmiaru double, dzięki czemu dane
+ * binarne mogą być interpretowane bezpośrednio, bez kopiowania.
+ */
+class DoubleBufferedReader {
+public:
+    /**
+     * @brief Uruchamia wątek czytający.
+     * @param input Otwarty strumień wejściowy (np. stdin).
+     * @param bufferBytes Rozmiar pojedynczego bufora w bajtach.
+     */
+    DoubleBufferedReader(std::FILE* input, std::size_t bufferBytes);
+    ~DoubleBufferedReader();
+
+    DoubleBufferedReader(const DoubleBufferedReader&) = delete;
+    DoubleBufferedReader& operator=(const DoubleBufferedReader&) = delete;
+
+    /**
+     * @brief Czeka na kolejny wypełniony bufor.
+     *
+     * Poprzednio pobrany bufor jest automatycznie zwracany wątkowi czytającemu.
+     *
+     * @param size Liczba bajtów w zwróconym buforze.
+     * @return Wskaźnik na dane lub nullptr po końcu strumienia.
+     */
+    const char* next(std::size_t& size);
+
+private:
+    void readLoop();
+
+    std::FILE* input;
+    std::vector<double> storage[2]; ///< Dwa bufory (typ double gwarantuje wyrównanie).
+    std::size_t filled[2] = { 0, 0 };
+    bool ready[2] = { false, false };
+    bool finished = false;
+    bool stopping = false;
+    int current = -1;  ///< Bufor aktualnie używany przez konsumenta.
+    int expected = 0;  ///< Bufor, który konsument odczyta jako następny.
+    std::mutex bufferMutex;
+    std::condition_variable changed;
+    std::thread reader;
+};
+
+/**
+ * @brief Uruchamia tryb strumieniowy (`PiIntegraation stream ...`).
+ *
+ * Opcje:
+ * - `--input plik`  – plik wejściowy zamiast stdin,
+ * - `--binary`      – wejście to surowe wartości double (little-endian),
+ * - `--column k`    – numer kolumny CSV z próbkami (domyślnie 0),
+ * - `--dt x`        – odstęp między próbkami (domyślnie 1),
+ * - `--report n`    – co ile próbek wypisać wynik częściowy,
+ * - `--buffer n`    – rozmiar bufora w bajtach.
+ *
+ * @return Kod zakończenia programu.
+ */
+int runStreamMode(int argc, char* argv[]);
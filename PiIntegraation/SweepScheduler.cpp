@@ -0,0 +1,599 @@
+﻿/**
+ * @file SweepScheduler.cpp
+ * @brief Implementacja adaptacyjnego przeglądu osi wątków, planera kolejności pomiarów,
+ * budżetu czasu i współbieżnego trybu przepustowości.
+ */
+
+#include "SweepScheduler.h"
+#include "CommandLine.h"
+#include "CpuAffinity.h"
+#include "Integration.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <thread>
+
+using namespace std;
+
+namespace {
+
+/// Ocena przedziału (a, b) między zmierzonymi liczbami wątków; 0 dla przedziałów bez punktów wewnętrznych.
+double intervalScore(const CellStatistics& first, const CellStatistics& a, const CellStatistics& b) {
+    if (b.threads - a.threads < 2) {
+        return 0.0;
+    }
+    double baseline = first.mean();
+    double efficiencyA = baseline / (a.threads * a.mean());
+    double efficiencyB = baseline / (b.threads * b.mean());
+    double variation = max(a.standardDeviation() / a.mean(), b.standardDeviation() / b.mean());
+    return fabs(efficiencyA - efficiencyB) + variation;
+}
+
+vector<long long> parseStepList(const string& text) {
+    vector<long long> values;
+    stringstream stream(text);
+    for (string item; getline(stream, item, ',');) {
+        values.push_back(static_cast<long long>(stod(item)));
+    }
+    return values;
+}
+
+/**
+ * @brief Wariant calculatePi(), w którym każdy wątek przypina się do rdzeni \p cores.
+ *
+ * Podział kroków jest taki sam jak w calculatePi(), więc wynik jest identyczny.
+ *
+ * @param pinned Ustawiane na false, jeśli któregoś wątku nie udało się przypiąć.
+ */
+double calculatePiOnCores(long long steps, int numThreads, const vector<int>& cores, atomic<bool>& pinned) {
+    double stepSize = 1.0 / static_cast<double>(steps);
+    long long stepsPerThread = steps / numThreads;
+    vector<thread> threads;
+    vector<double> partialResults(numThreads, 0.0);
+    for (int i = 0; i < numThreads; ++i) {
+        double start = i * stepsPerThread * stepSize;
+        double end = (i + 1) * stepsPerThread * stepSize;
+        threads.emplace_back([&, i, start, end] {
+            if (!pinCurrentThread(cores)) {
+                pinned = false;
+            }
+            calculatePartialIntegral(start, end, stepsPerThread, stepSize, partialResults[i]);
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    double pi = 0.0;
+    for (double result : partialResults) {
+        pi += result;
+    }
+    return pi;
+}
+
+} // namespace
+
+double CellStatistics::mean() const {
+    double sum = 0.0;
+    for (double value : seconds) {
+        sum += value;
+    }
+    return seconds.empty() ? 0.0 : sum / static_cast<double>(seconds.size());
+}
+
+double CellStatistics::standardDeviation() const {
+    if (seconds.size() < 2) {
+        return 0.0;
+    }
+    double average = mean();
+    double sum = 0.0;
+    for (double value : seconds) {
+        sum += (value - average) * (value - average);
+    }
+    return sqrt(sum / static_cast<double>(seconds.size() - 1));
+}
+
+CellStatistics measureCell(long long steps, int numThreads, int repeats) {
+    CellStatistics cell;
+    cell.steps = steps;
+    cell.threads = numThreads;
+    for (int i = 0; i < max(1, repeats); ++i) {
+        auto startTime = chrono::high_resolution_clock::now();
+        cell.pi = calculatePi(steps, numThreads);
+        chrono::duration<double> duration = chrono::high_resolution_clock::now() - startTime;
+        cell.seconds.push_back(duration.count());
+    }
+    return cell;
+}
+
+string samplePhaseName(SamplePhase phase) {
+    switch (phase) {
+    case SamplePhase::Geometric:
+        return "geometryczny";
+    case SamplePhase::Bisection:
+        return "bisekcja";
+    default:
+        return "interpolowany";
+    }
+}
+
+vector<ScalingPoint> adaptiveThreadSweep(long long steps, const AdaptiveSweepOptions& options) {
+    int maxThreads = max(1, options.maxThreads);
+    map<int, CellStatistics> measured;
+    map<int, SamplePhase> phases;
+    auto measure = [&](int threads, SamplePhase phase) {
+        measured[threads] = measureCell(steps, threads, options.repeats);
+        phases[threads] = phase;
+        const CellStatistics& cell = measured[threads];
+        cout << "Liczba kroków: " << steps << ", Wątki: " << threads << ", Czas: " << cell.mean()
+            << "s (±" << cell.standardDeviation() << "), PI: " << cell.pi << ", Punkt: " << samplePhaseName(phase) << endl;
+    };
+
+    // Etap 1: ciąg geometryczny i największa liczba wątków
+    for (int threads = 1; threads < maxThreads; threads *= 2) {
+        measure(threads, SamplePhase::Geometric);
+    }
+    measure(maxThreads, SamplePhase::Geometric);
+
+    // Etap 2: dzielenie przedziałów o najwyższej ocenie
+    while (static_cast<int>(measured.size()) < options.maxPoints) {
+        const CellStatistics& first = measured.begin()->second;
+        double bestScore = 0.0;
+        int bestMiddle = 0;
+        for (auto it = measured.begin(); next(it) != measured.end(); ++it) {
+            double score = intervalScore(first, it->second, next(it)->second);
+            if (score > bestScore) {
+                bestScore = score;
+                bestMiddle = (it->first + next(it)->first) / 2;
+            }
+        }
+        if (bestScore < options.tolerance) {
+            break;
+        }
+        measure(bestMiddle, SamplePhase::Bisection);
+    }
+
+    // Pełna krzywa: pomiary i interpolacja liniowa między nimi
+    vector<ScalingPoint> curve;
+    for (int threads = 1; threads <= maxThreads; ++threads) {
+        ScalingPoint point;
+        point.threads = threads;
+        auto upper = measured.lower_bound(threads);
+        if (upper->first == threads) {
+            point.seconds = upper->second.mean();
+            point.deviation = upper->second.standardDeviation();
+            point.pi = upper->second.pi;
+            point.phase = phases[threads];
+        }
+        else {
+            auto lower = prev(upper);
+            double fraction = static_cast<double>(threads - lower->first) / (upper->first - lower->first);
+            point.seconds = lower->second.mean() + fraction * (upper->second.mean() - lower->second.mean());
+        }
+        curve.push_back(point);
+    }
+    return curve;
+}
+
+int runAdaptiveSweepMode(int argc, char* argv[]) {
+    string stepsList = getOption(argc, argv, "--steps", "100000000,1000000000,3000000000");
+    string outputPath = getOption(argc, argv, "--output", "results_adaptive.csv");
+    AdaptiveSweepOptions options;
+    options.maxThreads = static_cast<int>(getIntOption(argc, argv, "--max-threads", options.maxThreads));
+    options.repeats = static_cast<int>(getIntOption(argc, argv, "--repeats", options.repeats));
+    options.maxPoints = static_cast<int>(getIntOption(argc, argv, "--max-points", options.maxPoints));
+    options.tolerance = getDoubleOption(argc, argv, "--tolerance", options.tolerance);
+
+    ofstream outputFile(outputPath);
+    if (!outputFile.is_open()) {
+        cerr << "Nie można otworzyć pliku " << outputPath << " do zapisu." << endl;
+        return 1;
+    }
+    outputFile << "Liczba krokow,Liczba watkow,Czas (s),Odchylenie (s),Przyblizona liczba PI,Punkt\n";
+
+    for (long long steps : parseStepList(stepsList)) {
+        auto startTime = chrono::high_resolution_clock::now();
+        vector<ScalingPoint> curve = adaptiveThreadSweep(steps, options);
+        chrono::duration<double> duration = chrono::high_resolution_clock::now() - startTime;
+
+        // Pełny przegląd z tą samą liczbą powtórzeń zmierzyłby każdą liczbę wątków
+        double fullSweep = 0.0;
+        int sampled = 0;
+        for (const ScalingPoint& point : curve) {
+            fullSweep += point.seconds * max(1, options.repeats);
+            sampled += point.phase != SamplePhase::Interpolated ? 1 : 0;
+            outputFile << steps << "," << point.threads << "," << point.seconds << "," << point.deviation << ",";
+            if (point.phase != SamplePhase::Interpolated) {
+                outputFile << point.pi;
+            }
+            outputFile << "," << samplePhaseName(point.phase) << "\n";
+        }
+        cout << "Liczba kroków: " << steps << ", Zmierzone liczby wątków: " << sampled << " z " << curve.size()
+            << ", Czas przeglądu: " << duration.count() << "s (pełny przegląd ok. " << fullSweep << "s)" << endl;
+    }
+    cout << "Wyniki zapisane do pliku " << outputPath << endl;
+    return 0;
+}
+
+vector<PlannedCell> planSweep(const vector<long long>& stepCounts, int maxThreads, int repeats,
+    int controlEvery, PlannedCell control, uint64_t seed) {
+    mt19937_64 generator(seed);
+    control.control = true;
+    vector<PlannedCell> plan;
+    plan.push_back(control);
+    int sinceControl = 0;
+    for (int repetition = 0; repetition < max(1, repeats); ++repetition) {
+        vector<PlannedCell> round;
+        for (long long steps : stepCounts) {
+            for (int threads = 1; threads <= maxThreads; ++threads) {
+                round.push_back({ steps, threads, repetition, false });
+            }
+        }
+        shuffle(round.begin(), round.end(), generator);
+        for (const PlannedCell& cell : round) {
+            plan.push_back(cell);
+            if (controlEvery > 0 && ++sinceControl == controlEvery) {
+                control.repetition = repetition;
+                plan.push_back(control);
+                sinceControl = 0;
+            }
+        }
+    }
+    if (!plan.back().control) {
+        plan.push_back(control);
+    }
+    return plan;
+}
+
+DriftReport detectDrift(const vector<int>& positions, const vector<double>& seconds, double threshold) {
+    DriftReport report;
+    size_t n = min(positions.size(), seconds.size());
+    report.samples = static_cast<int>(n);
+    if (n < 3) {
+        return report;
+    }
+
+    double meanPosition = 0.0, meanSeconds = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        meanPosition += positions[i];
+        meanSeconds += seconds[i];
+    }
+    meanPosition /= n;
+    meanSeconds /= n;
+
+    double sxx = 0.0, sxy = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        sxx += (positions[i] - meanPosition) * (positions[i] - meanPosition);
+        sxy += (positions[i] - meanPosition) * (seconds[i] - meanSeconds);
+    }
+    double slope = sxx > 0.0 ? sxy / sxx : 0.0;
+    double residuals = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        double predicted = meanSeconds + slope * (positions[i] - meanPosition);
+        residuals += (seconds[i] - predicted) * (seconds[i] - predicted);
+    }
+    double slopeError = sxx > 0.0 ? sqrt(residuals / (n - 2) / sxx) : 0.0;
+    report.trendStatistic = slopeError > 0.0 ? slope / slopeError : 0.0;
+    report.relativeDrift = slope * (positions[n - 1] - positions[0]) / meanSeconds;
+
+    size_t half = n / 2;
+    for (size_t i = 0; i < n; ++i) {
+        (i < half ? report.firstHalf : report.secondHalf) += seconds[i];
+    }
+    report.firstHalf /= half;
+    report.secondHalf /= (n - half);
+    report.detected = fabs(report.trendStatistic) > 3.0 && fabs(report.relativeDrift) > threshold;
+    return report;
+}
+
+int runPlannedSweepMode(int argc, char* argv[]) {
+    vector<long long> stepCounts = parseStepList(getOption(argc, argv, "--steps", "100000000,1000000000,3000000000"));
+    int maxThreads = static_cast<int>(max(1LL, getIntOption(argc, argv, "--max-threads", 50)));
+    int repeats = static_cast<int>(getIntOption(argc, argv, "--repeats", 3));
+    uint64_t seed = static_cast<uint64_t>(getIntOption(argc, argv, "--seed", 12345));
+    int controlEvery = static_cast<int>(getIntOption(argc, argv, "--control-every", 10));
+    double threshold = getDoubleOption(argc, argv, "--drift-threshold", 0.02);
+    string outputPath = getOption(argc, argv, "--output", "results_planned.csv");
+    PlannedCell control;
+    control.steps = getIntOption(argc, argv, "--control-steps", *min_element(stepCounts.begin(), stepCounts.end()));
+    control.threads = static_cast<int>(getIntOption(argc, argv, "--control-threads", 1));
+
+    ofstream outputFile(outputPath);
+    if (!outputFile.is_open()) {
+        cerr << "Nie można otworzyć pliku " << outputPath << " do zapisu." << endl;
+        return 1;
+    }
+    outputFile << "Kolejnosc,Liczba krokow,Liczba watkow,Powtorzenie,Kontrolna,Czas (s),Przyblizona liczba PI\n";
+
+    vector<PlannedCell> plan = planSweep(stepCounts, maxThreads, repeats, controlEvery, control, seed);
+    cout << "Plan: " << plan.size() << " pomiarów, Ziarno: " << seed << ", Komórka kontrolna: "
+        << control.steps << " kroków, " << control.threads << " wątków" << endl;
+
+    map<pair<long long, int>, CellStatistics> cells;
+    vector<int> controlPositions;
+    vector<double> controlSeconds;
+    for (size_t position = 0; position < plan.size(); ++position) {
+        const PlannedCell& cell = plan[position];
+        CellStatistics measured = measureCell(cell.steps, cell.threads, 1);
+        double seconds = measured.seconds.front();
+        outputFile << position << "," << cell.steps << "," << cell.threads << "," << cell.repetition << ","
+            << (cell.control ? 1 : 0) << "," << seconds << "," << measured.pi << "\n";
+        if (cell.control) {
+            controlPositions.push_back(static_cast<int>(position));
+            controlSeconds.push_back(seconds);
+            continue;
+        }
+        CellStatistics& statistics = cells[{ cell.steps, cell.threads }];
+        statistics.steps = cell.steps;
+        statistics.threads = cell.threads;
+        statistics.pi = measured.pi;
+        statistics.seconds.push_back(seconds);
+    }
+
+    for (const auto& entry : cells) {
+        const CellStatistics& cell = entry.second;
+        cout << "Liczba kroków: " << cell.steps << ", Wątki: " << cell.threads << ", Czas: " << cell.mean()
+            << "s (±" << cell.standardDeviation() << "), PI: " << cell.pi << endl;
+    }
+
+    DriftReport drift = detectDrift(controlPositions, controlSeconds, threshold);
+    cout << "Komórka kontrolna: " << drift.samples << " pomiarów, Pierwsza połowa: " << drift.firstHalf
+        << "s, Druga połowa: " << drift.secondHalf << "s, Trend: " << drift.relativeDrift * 100.0
+        << "% (t = " << drift.trendStatistic << "), Dryf: " << (drift.detected ? "WYKRYTY" : "nie wykryto") << endl;
+    cout << "Wyniki zapisane do pliku " << outputPath << endl;
+    return 0;
+}
+
+double RuntimeModel::predict(long long steps, int threads) const {
+    int parallel = max(1, min(threads, cores));
+    double efficiency = parallel > 1 ? parallelEfficiency : 1.0;
+    return threads * threadStartSeconds + static_cast<double>(steps) / (stepsPerSecond * parallel * efficiency);
+}
+
+long long RuntimeModel::affordableSteps(double seconds, int threads) const {
+    int parallel = max(1, min(threads, cores));
+    double efficiency = parallel > 1 ? parallelEfficiency : 1.0;
+    double computeSeconds = seconds - threads * threadStartSeconds;
+    return computeSeconds > 0.0 ? static_cast<long long>(computeSeconds * stepsPerSecond * parallel * efficiency) : 0;
+}
+
+RuntimeModel calibrateRuntime(long long calibrationSteps) {
+    const int repeats = 3;
+    const int startThreads = 16;
+    auto fastest = [](const CellStatistics& cell) { return *min_element(cell.seconds.begin(), cell.seconds.end()); };
+
+    RuntimeModel model;
+    model.cores = static_cast<int>(max(1u, thread::hardware_concurrency()));
+
+    // Koszt wątku: prawie pusta praca rozdzielona na wiele wątków
+    model.threadStartSeconds = fastest(measureCell(startThreads, startThreads, repeats)) / startThreads;
+
+    // Przepustowość jednego wątku (po odjęciu kosztu jego uruchomienia)
+    double single = fastest(measureCell(calibrationSteps, 1, repeats));
+    model.stepsPerSecond = calibrationSteps / max(1e-9, single - model.threadStartSeconds);
+
+    // Efektywność przy wszystkich rdzeniach
+    if (model.cores > 1) {
+        double parallel = fastest(measureCell(calibrationSteps, model.cores, repeats)) - model.cores * model.threadStartSeconds;
+        double ideal = static_cast<double>(calibrationSteps) / (model.stepsPerSecond * model.cores);
+        model.parallelEfficiency = min(1.0, max(0.05, ideal / max(1e-9, parallel)));
+    }
+    return model;
+}
+
+int runBudgetedSweepMode(int argc, char* argv[]) {
+    vector<long long> stepCounts = parseStepList(getOption(argc, argv, "--steps", "100000000,1000000000,3000000000"));
+    int maxThreads = static_cast<int>(max(1LL, getIntOption(argc, argv, "--max-threads", 50)));
+    double budget = getDoubleOption(argc, argv, "--budget", 0.0);
+    bool downsize = hasFlag(argc, argv, "--downsize");
+    long long minSteps = getIntOption(argc, argv, "--min-steps", 1000000);
+    long long calibrationSteps = getIntOption(argc, argv, "--calibration-steps", 20000000);
+    bool dryRun = hasFlag(argc, argv, "--dry-run");
+    string outputPath = getOption(argc, argv, "--output", "results_budgeted.csv");
+
+    auto calibrationStart = chrono::high_resolution_clock::now();
+    RuntimeModel model = calibrateRuntime(calibrationSteps);
+    chrono::duration<double> calibrationTime = chrono::high_resolution_clock::now() - calibrationStart;
+    cout << "Kalibracja: " << calibrationTime.count() << "s, Kroki/s na wątek: " << model.stepsPerSecond
+        << ", Koszt wątku: " << model.threadStartSeconds * 1e6 << " us, Rdzenie: " << model.cores
+        << ", Efektywność: " << model.parallelEfficiency << endl;
+
+    double predictedTotal = 0.0;
+    for (long long steps : stepCounts) {
+        double predictedSteps = 0.0;
+        for (int threads = 1; threads <= maxThreads; ++threads) {
+            predictedSteps += model.predict(steps, threads);
+        }
+        cout << "Liczba kroków: " << steps << ", Przewidywany czas: " << predictedSteps << "s" << endl;
+        predictedTotal += predictedSteps;
+    }
+    cout << "Przewidywany czas przeglądu: " << predictedTotal << "s";
+    if (budget > 0.0) {
+        cout << ", Budżet: " << budget << "s" << (predictedTotal > budget ? " - przegląd zostanie ograniczony" : "");
+    }
+    cout << endl;
+    if (dryRun) {
+        return 0;
+    }
+
+    ofstream outputFile(outputPath);
+    if (!outputFile.is_open()) {
+        cerr << "Nie można otworzyć pliku " << outputPath << " do zapisu." << endl;
+        return 1;
+    }
+    outputFile << "Liczba krokow (plan),Liczba krokow,Liczba watkow,Czas przewidywany (s),Czas (s),Przyblizona liczba PI,Status\n";
+
+    double elapsed = 0.0;
+    double predictedSum = 0.0, actualSum = 0.0;
+    for (long long plannedSteps : stepCounts) {
+        for (int threads = 1; threads <= maxThreads; ++threads) {
+            // Korekta modelu stosunkiem dotychczasowych czasów rzeczywistych do przewidywanych
+            double correction = predictedSum > 0.0 ? actualSum / predictedSum : 1.0;
+            long long steps = plannedSteps;
+            double predicted = model.predict(steps, threads) * correction;
+            string status = "wykonana";
+            if (budget > 0.0 && elapsed + predicted > budget) {
+                long long affordable = model.affordableSteps((budget - elapsed) / correction, threads);
+                if (downsize && affordable >= minSteps) {
+                    steps = affordable;
+                    predicted = model.predict(steps, threads) * correction;
+                    status = "zmniejszona";
+                }
+                else {
+                    outputFile << plannedSteps << ",0," << threads << "," << predicted << ",,,pominieta\n";
+                    cout << "Liczba kroków: " << plannedSteps << ", Wątki: " << threads
+                        << ", Przewidywany czas: " << predicted << "s - pominięta (budżet)" << endl;
+                    continue;
+                }
+            }
+
+            CellStatistics cell = measureCell(steps, threads, 1);
+            double actual = cell.seconds.front();
+            elapsed += actual;
+            predictedSum += predicted / correction;
+            actualSum += actual;
+            outputFile << plannedSteps << "," << steps << "," << threads << "," << predicted << "," << actual << ","
+                << cell.pi << "," << status << "\n";
+            cout << "Liczba kroków: " << steps << ", Wątki: " << threads << ", Przewidywany czas: " << predicted
+                << "s, Czas: " << actual << "s, PI: " << cell.pi
+                << (status == "zmniejszona" ? " (zmniejszona)" : "") << endl;
+        }
+    }
+    cout << "Czas przeglądu: " << elapsed << "s (przewidywany " << predictedTotal << "s)" << endl;
+    cout << "Wyniki zapisane do pliku " << outputPath << endl;
+    return 0;
+}
+
+int runThroughputSweepMode(int argc, char* argv[]) {
+    vector<long long> stepCounts = parseStepList(getOption(argc, argv, "--steps", "100000000,1000000000,3000000000"));
+    int maxThreads = static_cast<int>(max(1LL, getIntOption(argc, argv, "--max-threads", 50)));
+    int cores = static_cast<int>(max(1LL, getIntOption(argc, argv, "--cores", max(1u, thread::hardware_concurrency()))));
+    string outputPath = getOption(argc, argv, "--output", "results_throughput.csv");
+
+    ofstream outputFile(outputPath);
+    if (!outputFile.is_open()) {
+        cerr << "Nie można otworzyć pliku " << outputPath << " do zapisu." << endl;
+        return 1;
+    }
+
+    /**
+     * @brief Stan jednej komórki; pola wyniku zapisuje tylko jej wątek, resztę planista pod blokadą.
+     */
+    struct Cell {
+        long long steps = 0;
+        int threads = 0;
+        int need = 0;              ///< Liczba rdzeni grupy.
+        vector<int> assigned;      ///< Przydzielone rdzenie.
+        double seconds = 0.0;
+        double pi = 0.0;
+        bool contended = false;
+        bool running = false;
+        thread worker;
+    };
+    vector<Cell> cells;
+    cells.reserve(stepCounts.size() * maxThreads);
+    for (long long steps : stepCounts) {
+        for (int threads = 1; threads <= maxThreads; ++threads) {
+            Cell cell;
+            cell.steps = steps;
+            cell.threads = threads;
+            cell.need = min(threads, cores);
+            cells.push_back(std::move(cell));
+        }
+    }
+
+    // Kolejka oczekujących: największe grupy najpierw
+    vector<size_t> pending(cells.size());
+    for (size_t i = 0; i < pending.size(); ++i) {
+        pending[i] = i;
+    }
+    stable_sort(pending.begin(), pending.end(), [&](size_t a, size_t b) { return cells[a].need > cells[b].need; });
+
+    vector<bool> coreFree(cores, true);
+    int freeCores = cores;
+    int running = 0;
+    vector<size_t> finished;
+    mutex schedulerMutex;
+    condition_variable cellFinished;
+    atomic<bool> pinned{ true };
+
+    auto wallStart = chrono::high_resolution_clock::now();
+    unique_lock<mutex> lock(schedulerMutex);
+    while (!pending.empty() || running > 0) {
+        // Uruchom każdą oczekującą komórkę, która mieści się w wolnych rdzeniach
+        for (auto it = pending.begin(); it != pending.end() && freeCores > 0;) {
+            Cell& cell = cells[*it];
+            if (cell.need > freeCores) {
+                ++it;
+                continue;
+            }
+            for (int core = 0; core < cores && static_cast<int>(cell.assigned.size()) < cell.need; ++core) {
+                if (coreFree[core]) {
+                    coreFree[core] = false;
+                    cell.assigned.push_back(core);
+                }
+            }
+            freeCores -= cell.need;
+            if (running > 0) {
+                cell.contended = true;
+                for (Cell& other : cells) {
+                    other.contended = other.contended || other.running;
+                }
+            }
+            cell.running = true;
+            ++running;
+            size_t index = *it;
+            cell.worker = thread([&, index] {
+                Cell& own = cells[index];
+                auto startTime = chrono::high_resolution_clock::now();
+                double pi = calculatePiOnCores(own.steps, own.threads, own.assigned, pinned);
+                chrono::duration<double> duration = chrono::high_resolution_clock::now() - startTime;
+                lock_guard<mutex> guard(schedulerMutex);
+                own.pi = pi;
+                own.seconds = duration.count();
+                finished.push_back(index);
+                cellFinished.notify_one();
+            });
+            it = pending.erase(it);
+        }
+
+        cellFinished.wait(lock, [&] { return !finished.empty(); });
+        for (size_t index : finished) {
+            Cell& cell = cells[index];
+            cell.worker.join();
+            cell.running = false;
+            for (int core : cell.assigned) {
+                coreFree[core] = true;
+            }
+            freeCores += cell.need;
+            --running;
+            cout << "Liczba kroków: " << cell.steps << ", Wątki: " << cell.threads << ", Rdzenie: " << cell.need
+                << ", Czas: " << cell.seconds << "s, PI: " << cell.pi << (cell.contended ? " (kontencja)" : "") << endl;
+        }
+        finished.clear();
+    }
+    lock.unlock();
+    chrono::duration<double> wallTime = chrono::high_resolution_clock::now() - wallStart;
+
+    outputFile << "Liczba krokow,Liczba watkow,Czas (s),Przyblizona liczba PI,Rdzenie,Kontencja\n";
+    double sequential = 0.0;
+    for (const Cell& cell : cells) {
+        sequential += cell.seconds;
+        outputFile << cell.steps << "," << cell.threads << "," << cell.seconds << "," << cell.pi << ","
+            << cell.need << "," << (cell.contended ? 1 : 0) << "\n";
+    }
+    if (!pinned) {
+        cerr << "Uwaga: nie udało się przypiąć wątków do rdzeni, grupy rdzeni nie są wymuszone." << endl;
+    }
+    cout << "Czas przeglądu: " << wallTime.count() << "s (suma czasów komórek " << sequential << "s)" << endl;
+    cout << "Wyniki zapisane do pliku " << outputPath << endl;
+    return 0;
+}
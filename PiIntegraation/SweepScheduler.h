@@ -0,0 +1,222 @@
+﻿/**
+ * @file SweepScheduler.h
+ * @brief Planowanie pomiarów przeglądu wydajności (liczba kroków × liczba wątków).
+ *
+ * Pełny przegląd z runSweep() mierzy każdą liczbę wątków od 1 do 50, choć
+ * większość punktów krzywej skalowania leży na prostych odcinkach. Przegląd
+ * adaptacyjny mierzy najpierw geometryczny ciąg liczb wątków, a potem dzieli
+ * tylko te przedziały, w których krzywa się załamuje lub pomiary są niestabilne.
+ *
+ * Kolejność pomiarów też ma znaczenie: przegląd 1 → 50 wątków wiąże nagrzewanie
+ * się procesora i obciążenie tła z liczbą wątków. Planer wykonania losuje
+ * kolejność komórek w każdym powtórzeniu i wstawia komórki kontrolne, których
+ * czasy pozwalają wykryć dryf w trakcie przeglądu.
+ *
+ * Model czasu wykonania, skalibrowany krótkimi pomiarami przed przeglądem,
+ * przewiduje czas każdej komórki i całego przeglądu oraz pozwala zmieścić
+ * przegląd w zadanym budżecie czasu.
+ *
+ * Gdy potrzebne są tylko wyniki (a nie czasy bez zakłóceń), tryb przepustowości
+ * wykonuje wiele komórek jednocześnie na rozłącznych grupach rdzeni.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Powtórzone pomiary jednej komórki przeglądu.
+ */
+struct CellStatistics {
+    long long steps = 0;         ///< Liczba kroków całkowania.
+    int threads = 0;             ///< Liczba wątków.
+    std::vector<double> seconds; ///< Czasy kolejnych powtórzeń.
+    double pi = 0.0;             ///< Wynik ostatniego powtórzenia.
+
+    /// Średni czas powtórzeń.
+    double mean() const;
+
+    /// Odchylenie standardowe czasu (0 dla jednego powtórzenia).
+    double standardDeviation() const;
+};
+
+/**
+ * @brief Mierzy komórkę \p repeats razy metodą calculatePi() (ta sama co w runSweep()).
+ */
+CellStatistics measureCell(long long steps, int numThreads, int repeats);
+
+/// Sposób, w jaki punkt krzywej skalowania trafił do wyników.
+enum class SamplePhase {
+    Geometric,    ///< Zmierzony w początkowym ciągu geometrycznym 1, 2, 4, ...
+    Bisection,    ///< Zmierzony przy dzieleniu przedziału.
+    Interpolated, ///< Niezmierzony - czas interpolowany liniowo z sąsiednich pomiarów.
+};
+
+/**
+ * @brief Punkt krzywej skalowania dla jednej liczby wątków.
+ */
+struct ScalingPoint {
+    int threads = 0;
+    double seconds = 0.0;   ///< Średni (lub interpolowany) czas.
+    double deviation = 0.0; ///< Odchylenie standardowe pomiarów (0 dla interpolacji).
+    double pi = 0.0;        ///< Wynik obliczeń (0 dla interpolacji).
+    SamplePhase phase = SamplePhase::Interpolated;
+};
+
+/**
+ * @brief Parametry przeglądu adaptacyjnego.
+ */
+struct AdaptiveSweepOptions {
+    int maxThreads = 50;     ///< Największa liczba wątków (jak w runSweep()).
+    int repeats = 3;         ///< Powtórzenia każdego pomiaru (do oceny zmienności).
+    int maxPoints = 16;      ///< Limit zmierzonych liczb wątków na jedną liczbę kroków.
+    double tolerance = 0.05; ///< Przedziały o mniejszej ocenie nie są już dzielone.
+};
+
+/**
+ * @brief Adaptacyjny pomiar krzywej skalowania dla \p steps kroków.
+ *
+ * ### Wyjaśnienie działania:
+ * - Najpierw mierzone są liczby wątków 1, 2, 4, 8, ... oraz maxThreads.
+ * - Każdy przedział między sąsiednimi pomiarami dostaje ocenę: spadek
+ *   efektywności \( E(n) = T(1) / (n\,T(n)) \) na jego długości plus większy
+ *   ze współczynników zmienności \( \sigma / \bar{T} \) jego końców.
+ * - Przedział o najwyższej ocenie jest dzielony na pół i środek jest mierzony,
+ *   dopóki ocena przekracza tolerancję i nie wyczerpano limitu punktów.
+ * - Pozostałe liczby wątków są interpolowane i oznaczone jako takie.
+ *
+ * @return Punkty dla wszystkich liczb wątków od 1 do maxThreads.
+ */
+std::vector<ScalingPoint> adaptiveThreadSweep(long long steps, const AdaptiveSweepOptions& options);
+
+/// Nazwa sposobu pomiaru zapisywana w pliku wyników.
+std::string samplePhaseName(SamplePhase phase);
+
+/**
+ * @brief Uruchamia tryb `adaptive` - adaptacyjny przegląd osi wątków.
+ *
+ * Opcje: `--steps n[,n...]` (domyślnie jak w runSweep()), `--max-threads n`,
+ * `--repeats n`, `--max-points n`, `--tolerance x`, `--output plik`
+ * (domyślnie results_adaptive.csv). Wynik zawiera wszystkie liczby wątków,
+ * a kolumna "Punkt" odróżnia pomiary od interpolacji.
+ *
+ * @return Kod zakończenia programu.
+ */
+int runAdaptiveSweepMode(int argc, char* argv[]);
+
+/**
+ * @brief Jedna pozycja planu wykonania przeglądu.
+ */
+struct PlannedCell {
+    long long steps = 0;
+    int threads = 0;
+    int repetition = 0;   ///< Numer powtórzenia (runda planu).
+    bool control = false; ///< Komórka kontrolna - zawsze ta sama konfiguracja.
+};
+
+/**
+ * @brief Plan przeglądu z losową, przeplataną kolejnością komórek.
+ *
+ * Każde powtórzenie to osobna runda zawierająca wszystkie komórki
+ * (liczba kroków × liczba wątków 1..maxThreads) w kolejności losowanej
+ * generatorem o ziarnie \p seed, więc plan jest powtarzalny. Co \p controlEvery
+ * komórek (oraz na początku i końcu) wstawiana jest komórka kontrolna \p control.
+ */
+std::vector<PlannedCell> planSweep(const std::vector<long long>& stepCounts, int maxThreads, int repeats,
+    int controlEvery, PlannedCell control, std::uint64_t seed);
+
+/**
+ * @brief Wynik wykrywania dryfu z czasów komórki kontrolnej.
+ */
+struct DriftReport {
+    int samples = 0;             ///< Liczba pomiarów komórki kontrolnej.
+    double firstHalf = 0.0;      ///< Średni czas w pierwszej połowie przeglądu.
+    double secondHalf = 0.0;     ///< Średni czas w drugiej połowie przeglądu.
+    double relativeDrift = 0.0;  ///< Zmiana czasu według trendu liniowego na całym przeglądzie, względem średniej.
+    double trendStatistic = 0.0; ///< Statystyka t nachylenia trendu.
+    bool detected = false;       ///< Czy dryf jest istotny.
+};
+
+/**
+ * @brief Wykrywa dryf: regresja liniowa czasu komórki kontrolnej względem pozycji w planie.
+ *
+ * Dryf jest zgłaszany, gdy nachylenie jest istotne statystycznie (|t| > 3)
+ * i zmienia czas o więcej niż \p threshold (ułamek średniej) na całym przeglądzie.
+ */
+DriftReport detectDrift(const std::vector<int>& positions, const std::vector<double>& seconds, double threshold);
+
+/**
+ * @brief Uruchamia tryb `planned` - pełny przegląd w losowej, przeplatanej kolejności.
+ *
+ * Opcje: `--steps n[,n...]`, `--max-threads n`, `--repeats n`, `--seed n`,
+ * `--control-every n`, `--control-steps n`, `--control-threads n`,
+ * `--drift-threshold x`, `--output plik` (domyślnie results_planned.csv).
+ * Plik zawiera każdy pomiar z jego pozycją w planie; na konsoli wypisywane są
+ * średnie komórek i raport dryfu.
+ *
+ * @return Kod zakończenia programu.
+ */
+int runPlannedSweepMode(int argc, char* argv[]);
+
+/**
+ * @brief Model czasu komórki: koszt uruchomienia wątków plus kroki podzielone przez przepustowość.
+ *
+ * \( T(s, n) = n \cdot t_{wątek} + \frac{s}{r \cdot \min(n, rdzenie) \cdot e} \),
+ * gdzie r to liczba kroków na sekundę jednego wątku, a e to efektywność
+ * równoległa zmierzona przy wszystkich rdzeniach (e = 1 dla jednego wątku).
+ */
+struct RuntimeModel {
+    double stepsPerSecond = 0.0;     ///< Przepustowość jednego wątku (wywołania f() na sekundę).
+    double threadStartSeconds = 0.0; ///< Koszt utworzenia i dołączenia jednego wątku.
+    int cores = 1;                   ///< Liczba wątków sprzętowych.
+    double parallelEfficiency = 1.0; ///< Efektywność przy cores wątkach.
+
+    /// Przewidywany czas komórki w sekundach.
+    double predict(long long steps, int threads) const;
+
+    /// Największa liczba kroków, którą przy \p threads wątkach da się wykonać w \p seconds.
+    long long affordableSteps(double seconds, int threads) const;
+};
+
+/**
+ * @brief Kalibruje model krótkimi pomiarami calculatePi().
+ *
+ * @param calibrationSteps Liczba kroków pomiarów przepustowości (ok. 0,1 s pracy).
+ */
+RuntimeModel calibrateRuntime(long long calibrationSteps);
+
+/**
+ * @brief Uruchamia tryb `budgeted` - przegląd z przewidywaniem czasu i budżetem.
+ *
+ * Opcje: `--steps n[,n...]`, `--max-threads n`, `--budget s` (0 - bez limitu),
+ * `--downsize` (komórki przekraczające budżet są zmniejszane zamiast pomijane),
+ * `--min-steps n`, `--calibration-steps n`, `--dry-run` (tylko przewidywanie),
+ * `--output plik` (domyślnie results_budgeted.csv). Dla każdej komórki zapisywany
+ * jest czas przewidywany i rzeczywisty; przewidywania kolejnych komórek są
+ * korygowane stosunkiem czasu rzeczywistego do przewidywanego z dotychczasowych.
+ *
+ * @return Kod zakończenia programu.
+ */
+int runBudgetedSweepMode(int argc, char* argv[]);
+
+/**
+ * @brief Uruchamia tryb `throughput` - komórki przeglądu wykonywane współbieżnie.
+ *
+ * ### Wyjaśnienie działania:
+ * - Komórka z n wątkami potrzebuje min(n, rdzenie) rdzeni.
+ * - Komórki czekające są posortowane malejąco według liczby rdzeni; gdy tylko
+ *   zwolnią się rdzenie, uruchamiana jest największa komórka, która się mieści
+ *   (dynamiczne pakowanie "największy pasujący").
+ * - Wątki komórki są przypinane do przydzielonej jej, rozłącznej grupy rdzeni.
+ * - Czas komórki, która choć przez chwilę działała równolegle z inną, jest
+ *   oznaczany jako zakłócony (kolumna "Kontencja") - dzielona pamięć podręczna
+ *   i przepustowość pamięci mogą go zawyżać.
+ *
+ * Opcje: `--steps n[,n...]`, `--max-threads n`, `--cores n` (domyślnie liczba
+ * wątków sprzętowych), `--output plik` (domyślnie results_throughput.csv).
+ *
+ * @return Kod zakończenia programu.
+ */
+int runThroughputSweepMode(int argc, char* argv[]);
@@ -0,0 +1,122 @@
+﻿/**
+ * @file Task.h
+ * @brief Zadanie puli wątków - przenoszalny obiekt wywoływalny z buforem wewnętrznym.
+ *
+ * std::function wymaga kopiowalności i dla większych domknięć alokuje pamięć
+ * na stercie. Task jest tylko przenoszalny, a domknięcia do inlineSize bajtów
+ * (np. zakres fragmentu całki, wskaźnik na stan pętli i na funkcję) przechowuje
+ * we własnym buforze - utworzenie, przeniesienie do kolejki i wykonanie
+ * zadania nie alokują. Większe domknięcia trafiają na stertę.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief Przenoszalne zadanie bez argumentów i wyniku (odpowiednik std::move_only_function<void()>).
+ */
+class Task {
+public:
+    /// Rozmiar bufora wewnętrznego w bajtach.
+    static constexpr std::size_t inlineSize = 56;
+
+    Task() = default;
+
+    /// Opakowuje obiekt wywoływalny \p function (w buforze, jeśli się mieści).
+    template <typename Function, typename = std::enable_if_t<!std::is_same_v<std::decay_t<Function>, Task>>>
+    Task(Function&& function) {
+        using Stored = std::decay_t<Function>;
+        if constexpr (fitsInline<Stored>()) {
+            new (storage) Stored(std::forward<Function>(function));
+            operations = &inlineOperations<Stored>;
+        }
+        else {
+            new (storage) Stored*(new Stored(std::forward<Function>(function)));
+            operations = &heapOperations<Stored>;
+        }
+    }
+
+    Task(Task&& other) noexcept : operations(other.operations) {
+        if (operations) {
+            operations->move(storage, other.storage);
+            other.operations = nullptr;
+        }
+    }
+
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            reset();
+            operations = other.operations;
+            if (operations) {
+                operations->move(storage, other.storage);
+                other.operations = nullptr;
+            }
+        }
+        return *this;
+    }
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    ~Task() {
+        reset();
+    }
+
+    /// Czy zadanie zawiera obiekt wywoływalny.
+    explicit operator bool() const { return operations != nullptr; }
+
+    /// Czy obiekt wywoływalny jest przechowywany w buforze wewnętrznym.
+    bool isInline() const { return operations && operations->isInline; }
+
+    /// Wykonuje zadanie.
+    void operator()() { operations->invoke(storage); }
+
+    /// Czy obiekt typu \p Function zmieści się w buforze wewnętrznym.
+    template <typename Function>
+    static constexpr bool fitsInline() {
+        return sizeof(Function) <= inlineSize && alignof(Function) <= alignof(std::max_align_t)
+            && std::is_nothrow_move_constructible_v<Function>;
+    }
+
+private:
+    /// Tablica operacji dla typu przechowywanego obiektu.
+    struct Operations {
+        void (*invoke)(void* storage);
+        void (*move)(void* destination, void* source); ///< Przenosi i niszczy źródło.
+        void (*destroy)(void* storage);
+        bool isInline;
+    };
+
+    template <typename Stored>
+    static constexpr Operations inlineOperations = {
+        [](void* storage) { (*static_cast<Stored*>(storage))(); },
+        [](void* destination, void* source) {
+            new (destination) Stored(std::move(*static_cast<Stored*>(source)));
+            static_cast<Stored*>(source)->~Stored();
+        },
+        [](void* storage) { static_cast<Stored*>(storage)->~Stored(); },
+        true,
+    };
+
+    template <typename Stored>
+    static constexpr Operations heapOperations = {
+        [](void* storage) { (**static_cast<Stored**>(storage))(); },
+        [](void* destination, void* source) { new (destination) Stored*(*static_cast<Stored**>(source)); },
+        [](void* storage) { delete *static_cast<Stored**>(storage); },
+        false,
+    };
+
+    void reset() {
+        if (operations) {
+            operations->destroy(storage);
+            operations = nullptr;
+        }
+    }
+
+    alignas(std::max_align_t) unsigned char storage[inlineSize];
+    const Operations* operations = nullptr;
+};
@@ -0,0 +1,156 @@
+﻿/**
+ * @file ThreadPool.cpp
+ * @brief Implementacja puli wątków.
+ */
+
+#include "ThreadPool.h"
+#include "Tracing.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+
+using namespace std;
+
+ThreadPool::ThreadPool(unsigned numThreads) {
+    numThreads = max(1u, numThreads);
+    for (unsigned i = 0; i < numThreads; ++i) {
+        workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        lock_guard<mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    available.notify_all();
+    for (auto& t : workers) {
+        t.join();
+    }
+}
+
+const char* taskPriorityName(TaskPriority priority) {
+    switch (priority) {
+    case TaskPriority::High:
+        return "wysoki";
+    case TaskPriority::Normal:
+        return "zwykły";
+    case TaskPriority::Low:
+        return "niski";
+    }
+    return "?";
+}
+
+void ThreadPool::submit(Task task, TaskPriority priority) {
+    // Pełna kolejka: opróżniaj ją samemu zamiast czekać (wywołujący może być jedynym wolnym wątkiem puli)
+    while (!tasks[static_cast<int>(priority)].tryPush(std::move(task))) {
+        if (!runPendingTask()) {
+            this_thread::yield();
+        }
+    }
+    queued.fetch_add(1);
+    // Blokada tylko wtedy, gdy jakiś wątek śpi - kolejność operacji seq_cst wyklucza zgubione budzenie
+    if (sleeping.load() > 0) {
+        lock_guard<mutex> lock(sleepMutex);
+        available.notify_one();
+    }
+}
+
+bool ThreadPool::runPendingTask() {
+    Task task;
+    bool found = false;
+    for (int priority = 0; priority < taskPriorityCount && !found; ++priority) {
+        found = tasks[priority].tryPop(task);
+    }
+    if (!found) {
+        return false;
+    }
+    queued.fetch_sub(1);
+    task();
+    return true;
+}
+
+void ThreadPool::workerLoop() {
+    while (true) {
+        if (runPendingTask()) {
+            continue;
+        }
+        unique_lock<mutex> lock(sleepMutex);
+        ++sleeping;
+        available.wait(lock, [&] { return stopping || queued.load() > 0; });
+        --sleeping;
+        if (stopping && queued.load() == 0) {
+            return;
+        }
+    }
+}
+
+void ThreadPool::parallelFor(long long count, int chunks, const function<void(long long, long long, int)>& body) {
+    if (count <= 0) {
+        return;
+    }
+    chunks = static_cast<int>(max(1LL, min<long long>(chunks, count)));
+
+    /**
+     * @brief Stan wspólny dla wszystkich uczestników pętli.
+     *
+     * Przechowywany w shared_ptr, ponieważ zadanie pomocnicze może zostać
+     * uruchomione przez pulę już po zakończeniu parallelFor().
+     */
+    struct Loop {
+        atomic<int> nextChunk{ 0 };
+        int finishedChunks = 0;
+        mutex doneMutex;
+        condition_variable done;
+    };
+    auto loop = make_shared<Loop>();
+
+    auto work = [loop, count, chunks, &body]() {
+        int finished = 0;
+        for (int chunk = loop->nextChunk++; chunk < chunks; chunk = loop->nextChunk++) {
+            long long begin = count * chunk / chunks;
+            long long end = count * (chunk + 1) / chunks;
+            PI_TRACE3(pool_chunk_start, chunk, begin, end);
+            body(begin, end, chunk);
+            PI_TRACE3(pool_chunk_end, chunk, begin, end);
+            ++finished;
+        }
+        if (finished > 0) {
+            lock_guard<mutex> lock(loop->doneMutex);
+            loop->finishedChunks += finished;
+            if (loop->finishedChunks == chunks) {
+                loop->done.notify_all();
+            }
+        }
+    };
+
+    // Wątki puli dołączają do pętli, wątek wywołujący również pobiera fragmenty
+    int helpers = min<int>(chunks - 1, static_cast<int>(workers.size()));
+    for (int i = 0; i < helpers; ++i) {
+        submit(work);
+    }
+    work();
+
+    // Pomoc w oczekiwaniu: zamiast blokować wątek (także wątek puli w zagnieżdżonej
+    // pętli), wykonuj inne zadania z kolejki, aż pozostałe fragmenty się zakończą
+    auto finished = [&] { return loop->finishedChunks == chunks; };
+    while (true) {
+        {
+            lock_guard<mutex> lock(loop->doneMutex);
+            if (finished()) {
+                return;
+            }
+        }
+        if (!runPendingTask()) {
+            unique_lock<mutex> lock(loop->doneMutex);
+            loop->done.wait_for(lock, chrono::microseconds(200), finished);
+        }
+    }
+}
+
+ThreadPool& ThreadPool::shared() {
+    static ThreadPool pool(max(1u, thread::hardware_concurrency()));
+    return pool;
+}
@@ -0,0 +1,117 @@
+﻿/**
+ * @file ThreadPool.h
+ * @brief Pula wątków roboczych wielokrotnego użytku.
+ *
+ * Główny przegląd wydajności tworzy nowe wątki dla każdej konfiguracji, co jest
+ * celowe przy pomiarze skalowania. Pozostałe silniki obliczeniowe korzystają
+ * z tej puli, aby nie płacić kosztu tworzenia wątków przy każdym wywołaniu.
+ *
+ * Zadania (Task, bez alokacji dla małych domknięć) trafiają do kolejki bez
+ * blokad MpmcQueue. Muteks i zmienna warunkowa służą tylko do usypiania
+ * bezczynnych wątków i budzenia ich, gdy ktoś czeka. Każda klasa priorytetu
+ * ma własną kolejkę; wolny wątek zawsze pobiera zadanie z najwyższej
+ * niepustej klasy, więc zadania pilne wyprzedzają czekające zadania tła
+ * (ale nie przerywają już wykonywanych - stąd podział dużych obliczeń na
+ * fragmenty, patrz IntegrationScheduler.h).
+ */
+
+#pragma once
+
+#include "MpmcQueue.h"
+#include "Task.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Klasy priorytetu zadań puli, od najpilniejszej.
+ */
+enum class TaskPriority {
+    High,   ///< Krótkie zadania wrażliwe na opóźnienie.
+    Normal, ///< Domyślna klasa (m.in. fragmenty parallelFor()).
+    Low,    ///< Zadania tła, np. wielosekundowe całkowania.
+};
+
+/// Liczba klas priorytetu.
+constexpr int taskPriorityCount = 3;
+
+/// Pojemność kolejki zadań jednej klasy priorytetu (patrz ThreadPool::submit()).
+constexpr std::size_t taskQueueCapacity = 2048;
+
+/// Polska nazwa klasy priorytetu.
+const char* taskPriorityName(TaskPriority priority);
+
+/**
+ * @brief Pula o stałej liczbie wątków z ograniczonymi kolejkami zadań bez blokad (po jednej na klasę priorytetu).
+ */
+class ThreadPool {
+public:
+    /**
+     * @brief Uruchamia \p numThreads wątków roboczych.
+     * @param numThreads Liczba wątków (co najmniej 1).
+     */
+    explicit ThreadPool(unsigned numThreads);
+
+    /// Kończy pracę puli po wykonaniu zadań pozostałych w kolejce.
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Dodaje zadanie do kolejki klasy \p priority.
+     *
+     * Kolejka każdej klasy mieści taskQueueCapacity zadań. Gdy jest pełna,
+     * wątek wywołujący sam wykonuje oczekujące zadania (runPendingTask()), aż
+     * zwolni się miejsce - dzięki temu zadanie zgłaszające wiele zadań z wnętrza
+     * puli nie zakleszcza się, czekając na wątki, które są zajęte.
+     */
+    void submit(Task task, TaskPriority priority = TaskPriority::Normal);
+
+    /**
+     * @brief Równoległa pętla po przedziale [0, \p count).
+     *
+     * Przedział jest dzielony na \p chunks fragmentów, które wątki puli
+     * (oraz wątek wywołujący) pobierają dynamicznie, co wyrównuje obciążenie
+     * przy fragmentach o różnym koszcie. Funkcja wraca po wykonaniu wszystkich fragmentów.
+     *
+     * Wywołania można zagnieżdżać (\p body może wywołać parallelFor() na tej
+     * samej puli): czekając na fragmenty pobrane przez inne wątki, wątek
+     * wywołujący wykonuje inne zadania z kolejki (runPendingTask()), więc
+     * liczba aktywnych wątków nigdy nie przekracza rozmiaru puli + wątków wywołujących.
+     *
+     * @param count Liczba iteracji.
+     * @param chunks Liczba fragmentów.
+     * @param body Funkcja wywoływana jako body(początek, koniec, numer fragmentu).
+     */
+    void parallelFor(long long count, int chunks, const std::function<void(long long, long long, int)>& body);
+
+    /**
+     * @brief Wykonuje jedno oczekujące zadanie (z najwyższej niepustej klasy) w bieżącym wątku.
+     * @return false, jeśli wszystkie kolejki były puste.
+     */
+    bool runPendingTask();
+
+    /// Liczba wątków roboczych.
+    unsigned size() const { return static_cast<unsigned>(workers.size()); }
+
+    /// Wspólna pula o rozmiarze równym liczbie wątków sprzętowych.
+    static ThreadPool& shared();
+
+private:
+    void workerLoop();
+
+    std::vector<std::thread> workers;
+    MpmcQueue<Task> tasks[taskPriorityCount] = { MpmcQueue<Task>(taskQueueCapacity), MpmcQueue<Task>(taskQueueCapacity),
+        MpmcQueue<Task>(taskQueueCapacity) };
+    std::atomic<long long> queued{ 0 };  ///< Liczba zadań we wszystkich kolejkach (do usypiania wątków).
+    std::atomic<int> sleeping{ 0 };      ///< Liczba uśpionych wątków roboczych.
+    std::mutex sleepMutex;
+    std::condition_variable available;
+    std::atomic<bool> stopping{ false };
+};
@@ -0,0 +1,44 @@
+﻿/**
+ * @file Tracing.h
+ * @brief Statyczne punkty śledzenia USDT (bpftrace, perf, SystemTap).
+ *
+ * Jeśli dostępny jest nagłówek <sys/sdt.h> (pakiet systemtap-sdt-dev lub
+ * systemtap-sdt-devel), makra PI_TRACE* wstawiają w kod sondy dostawcy `pi`.
+ * Niepodłączona sonda to pojedyncza instrukcja nop - argumenty są tylko
+ * opisane w sekcji .note.stapsdt pliku wykonywalnego. Bez nagłówka (np. na
+ * Windows) makra nie generują żadnego kodu. Kompilację z sondami można
+ * wyłączyć definicją PI_DISABLE_USDT.
+ *
+ * Sondy (argumenty to liczby całkowite):
+ * - `integration_start(steps, threads)`, `integration_end(steps, threads)` - calculatePi(),
+ * - `chunk_start(firstStep, steps)`, `chunk_end(firstStep, steps)` - fragment wątku metody prostokątów,
+ * - `pool_chunk_start(chunk, begin, end)`, `pool_chunk_end(chunk, begin, end)` - ThreadPool::parallelFor(),
+ * - `reduction_start(parts)`, `reduction_end(parts)` - sumowanie wyników częściowych,
+ * - `output_batch(rows)` - zapis partii wierszy przez ResultsWriter.
+ *
+ * Przykład - czas każdego fragmentu w działającym procesie:
+ * @code
+ * bpftrace -p PID -e 'usdt:./pi:pi:chunk_start { @s[tid] = nsecs; }
+ *   usdt:./pi:pi:chunk_end /@s[tid]/ { @ns = hist(nsecs - @s[tid]); delete(@s[tid]); }'
+ * @endcode
+ */
+
+#pragma once
+
+#if !defined(PI_DISABLE_USDT) && defined(__has_include)
+#if __has_include(<sys/sdt.h>)
+#define PI_USDT 1
+#endif
+#endif
+
+#ifdef PI_USDT
+#include <sys/sdt.h>
+#define PI_TRACE1(name, a) DTRACE_PROBE1(pi, name, a)
+#define PI_TRACE2(name, a, b) DTRACE_PROBE2(pi, name, a, b)
+#define PI_TRACE3(name, a, b, c) DTRACE_PROBE3(pi, name, a, b, c)
+#else
+// sizeof nie oblicza argumentów, a jedynie oznacza je jako użyte
+#define PI_TRACE1(name, a) ((void)sizeof(a))
+#define PI_TRACE2(name, a, b) ((void)sizeof(a), (void)sizeof(b))
+#define PI_TRACE3(name, a, b, c) ((void)sizeof(a), (void)sizeof(b), (void)sizeof(c))
+#endif